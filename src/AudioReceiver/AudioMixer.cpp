@@ -0,0 +1,105 @@
+#include "AudioMixer.hpp"
+
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define AUDIO_MIXER_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define AUDIO_MIXER_NEON 1
+#endif
+
+namespace {
+
+inline int16_t Saturate(int32_t value) {
+    return static_cast<int16_t>(std::min<int32_t>(32767, std::max<int32_t>(-32768, value)));
+}
+
+// acc[i] += input[i]
+void Accumulate(int32_t* acc, const int16_t* input, size_t n) {
+    size_t i = 0;
+#if defined(AUDIO_MIXER_SSE2)
+    for (; i + 8 <= n; i += 8) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+        // Sign-extend 8 x int16 into two 4 x int32 halves
+        const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+        const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+        __m128i* a = reinterpret_cast<__m128i*>(acc + i);
+        _mm_storeu_si128(a, _mm_add_epi32(_mm_loadu_si128(a), lo));
+        _mm_storeu_si128(a + 1, _mm_add_epi32(_mm_loadu_si128(a + 1), hi));
+    }
+#elif defined(AUDIO_MIXER_NEON)
+    for (; i + 8 <= n; i += 8) {
+        const int16x8_t v = vld1q_s16(input + i);
+        vst1q_s32(acc + i, vaddw_s16(vld1q_s32(acc + i), vget_low_s16(v)));
+        vst1q_s32(acc + i + 4, vaddw_s16(vld1q_s32(acc + i + 4), vget_high_s16(v)));
+    }
+#endif
+    for (; i < n; ++i) {
+        acc[i] += input[i];
+    }
+}
+
+// out[i] = saturate(acc[i] - (input ? input[i] : 0))
+void SaturateOut(int16_t* out, const int32_t* acc, const int16_t* input, size_t n) {
+    size_t i = 0;
+#if defined(AUDIO_MIXER_SSE2)
+    for (; i + 8 <= n; i += 8) {
+        __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(acc + i));
+        __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(acc + i + 4));
+        if (input) {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+            lo = _mm_sub_epi32(lo, _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16));
+            hi = _mm_sub_epi32(hi, _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16));
+        }
+        // packs saturates int32 to int16
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packs_epi32(lo, hi));
+    }
+#elif defined(AUDIO_MIXER_NEON)
+    for (; i + 8 <= n; i += 8) {
+        int32x4_t lo = vld1q_s32(acc + i);
+        int32x4_t hi = vld1q_s32(acc + i + 4);
+        if (input) {
+            const int16x8_t v = vld1q_s16(input + i);
+            lo = vsubw_s16(lo, vget_low_s16(v));
+            hi = vsubw_s16(hi, vget_high_s16(v));
+        }
+        // vqmovn saturates int32 to int16
+        vst1q_s16(out + i, vcombine_s16(vqmovn_s32(lo), vqmovn_s32(hi)));
+    }
+#endif
+    for (; i < n; ++i) {
+        out[i] = Saturate(acc[i] - (input ? input[i] : 0));
+    }
+}
+
+} // namespace
+
+AudioMixer::AudioMixer(size_t frameSamples)
+    : _frameSamples(frameSamples)
+    , _accumulator(frameSamples) {
+}
+
+void AudioMixer::Mix(const std::vector<const int16_t*>& inputs,
+                     int16_t* mix,
+                     const std::vector<int16_t*>* mixMinus) {
+    int32_t* acc = _accumulator.data();
+    const size_t n = _frameSamples;
+
+    std::fill(acc, acc + n, 0);
+    for (const int16_t* input : inputs) {
+        Accumulate(acc, input, n);
+    }
+
+    SaturateOut(mix, acc, nullptr, n);
+
+    if (!mixMinus) {
+        return;
+    }
+    for (size_t k = 0; k < inputs.size() && k < mixMinus->size(); ++k) {
+        if ((*mixMinus)[k]) {
+            SaturateOut((*mixMinus)[k], acc, inputs[k], n);
+        }
+    }
+}
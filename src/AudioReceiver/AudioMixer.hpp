@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Mixes N int16 frames of the same length.
+// Samples are summed in an int32 accumulator and saturated once at the end,
+// so clipping happens only in the final result. Mix-minus outputs (everyone
+// except participant k) are derived as sum - input[k], which keeps the work
+// O(N) per sample instead of O(N^2).
+// The inner loops use SSE2 on x86 and NEON on ARM (8 samples per step, with the
+// final int32 -> int16 saturation done by packs / vqmovn); other targets and
+// tails shorter than 8 samples use the scalar loop.
+class AudioMixer {
+public:
+    explicit AudioMixer(size_t frameSamples);
+
+    // inputs[k] points to frameSamples samples of participant k.
+    // mix receives the full mix; mixMinus (optional, same size as inputs)
+    // receives per-participant outputs without their own signal.
+    void Mix(const std::vector<const int16_t*>& inputs,
+             int16_t* mix,
+             const std::vector<int16_t*>* mixMinus = nullptr);
+
+    size_t GetFrameSamples() const { return _frameSamples; }
+
+private:
+    size_t _frameSamples;
+    std::vector<int32_t> _accumulator;
+};
@@ -0,0 +1,190 @@
+#include "AudioReceiver.hpp"
+
+#include "../AudioRecorder/NoiseSuppressor.hpp"
+#include "Rtp.hpp"
+
+#include <opus.h>
+
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+void OpusDecoderDeleter::operator()(OpusDecoder* ptr) const noexcept {
+    if (ptr) {
+        opus_decoder_destroy(ptr);
+    }
+}
+
+AudioReceiver::Participant::Participant(unsigned int sampleRate, size_t frameSamples, size_t jitterFrames)
+    : sampleRate(sampleRate)
+    , decoded(sampleRate * 120 / 1000)  // longest Opus packet: 120 ms
+    , jitter(frameSamples, jitterFrames, jitterFrames * 4)
+    , frame(frameSamples, 0)
+{
+    int error = OPUS_OK;
+    decoder.reset(opus_decoder_create(static_cast<opus_int32>(sampleRate), 1, &error));
+    if (error != OPUS_OK || !decoder) {
+        throw std::runtime_error(std::string("Failed to create Opus decoder: ") + opus_strerror(error));
+    }
+}
+
+AudioReceiver::Participant::~Participant() = default;
+
+void AudioReceiver::Participant::Receive(const rtc::binary& packet) {
+    Rtp::Packet rtp;
+    if (!Rtp::ReadPacket(packet.data(), packet.size(), rtp) || rtp.payloadSize == 0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> processLock(processMutex);
+    const int decodedSamples = opus_decode(decoder.get(), rtp.payload, static_cast<opus_int32>(rtp.payloadSize),
+                                           decoded.data(), static_cast<int>(decoded.size()), 0);
+    if (decodedSamples > 0) {
+        PushLocked(decoded.data(), static_cast<size_t>(decodedSamples));
+    }
+}
+
+void AudioReceiver::Participant::Push(const int16_t* samples, size_t numSamples) {
+    if (numSamples == 0) return;
+
+    std::lock_guard<std::mutex> processLock(processMutex);
+    PushLocked(samples, numSamples);
+}
+
+void AudioReceiver::Participant::PushLocked(const int16_t* samples, size_t numSamples) {
+    if (suppressor) {
+        suppressor->ProcessSamples(samples, numSamples, sampleRate, sampleRate, processed);
+        samples = processed.data();
+        numSamples = processed.size();
+    }
+
+    std::lock_guard<std::mutex> jitterLock(jitterMutex);
+    jitter.Push(samples, numSamples);
+}
+
+AudioReceiver::AudioReceiver(unsigned int sampleRate,
+                             size_t frameSamples,
+                             size_t jitterFrames)
+    : _sampleRate(sampleRate)
+    , _frameSamples(frameSamples)
+    , _jitterFrames(jitterFrames)
+    , _mixer(frameSamples)
+{
+    if (sampleRate != 8000 && sampleRate != 12000 && sampleRate != 16000
+        && sampleRate != 24000 && sampleRate != 48000) {
+        throw std::runtime_error("AudioReceiver: Opus cannot decode to " + std::to_string(sampleRate) + " Hz");
+    }
+}
+
+AudioReceiver::~AudioReceiver() {
+    std::lock_guard<std::mutex> lock(_participantsMutex);
+    for (auto& [id, participant] : _participants) {
+        Detach(participant->track);
+    }
+}
+
+std::shared_ptr<AudioReceiver::Participant> AudioReceiver::GetOrCreate(const std::string& id) {
+    std::lock_guard<std::mutex> lock(_participantsMutex);
+    auto& participant = _participants[id];
+    if (!participant) {
+        participant = std::make_shared<Participant>(_sampleRate, _frameSamples, _jitterFrames);
+    }
+    return participant;
+}
+
+void AudioReceiver::AddParticipant(const std::string& id, PeerConnectionPtr pc, bool denoise) {
+    if (!pc) return;
+
+    // Describe an incoming audio track, mirroring AudioSender::AttachTrack()
+    rtc::Description::Audio audioDesc(kTrackMid, rtc::Description::Direction::RecvOnly);
+    audioDesc.addOpusCodec(111);
+    AttachTrack(id, pc->addTrack(audioDesc), denoise);
+}
+
+void AudioReceiver::AttachTrack(const std::string& id, std::shared_ptr<rtc::Track> track, bool denoise) {
+    auto participant = GetOrCreate(id);
+    {
+        std::lock_guard<std::mutex> lock(participant->processMutex);
+        if (denoise && !participant->suppressor) {
+            participant->suppressor = std::make_unique<NoiseSuppressor>();
+            participant->suppressor->SetEnabled(true);
+        }
+    }
+
+    std::shared_ptr<rtc::Track> previous;
+    {
+        std::lock_guard<std::mutex> lock(_participantsMutex);
+        previous = std::exchange(participant->track, track);
+    }
+    if (previous != track) {
+        Detach(previous);
+    }
+    if (!track) return;
+
+    // The handler only holds the participant weakly and never touches the
+    // receiver, so it stays safe even if it races with destruction
+    std::weak_ptr<Participant> weak = participant;
+    track->onMessage(
+        [weak](rtc::binary packet) {
+            if (auto locked = weak.lock()) {
+                locked->Receive(packet);
+            }
+        },
+        nullptr);
+}
+
+void AudioReceiver::RemoveParticipant(const std::string& id) {
+    std::shared_ptr<rtc::Track> track;
+    {
+        std::lock_guard<std::mutex> lock(_participantsMutex);
+        auto it = _participants.find(id);
+        if (it == _participants.end()) return;
+        track = std::move(it->second->track);
+        _participants.erase(it);
+    }
+    Detach(track);
+}
+
+void AudioReceiver::Detach(const std::shared_ptr<rtc::Track>& track) {
+    if (track) {
+        track->onMessage(nullptr, nullptr);
+    }
+}
+
+void AudioReceiver::OnAudioBuffer(const std::string& id, const int16_t* samples, size_t numSamples) {
+    if (!samples || numSamples == 0) return;
+    GetOrCreate(id)->Push(samples, numSamples);
+}
+
+void AudioReceiver::Mix(std::vector<int16_t>& mix,
+                        std::map<std::string, std::vector<int16_t>>* mixMinus) {
+    std::lock_guard<std::mutex> lock(_participantsMutex);
+
+    mix.resize(_frameSamples);
+    _inputs.clear();
+    _outputs.clear();
+
+    if (mixMinus) {
+        // Drop frames of participants that have been removed
+        for (auto it = mixMinus->begin(); it != mixMinus->end();) {
+            it = _participants.count(it->first) ? std::next(it) : mixMinus->erase(it);
+        }
+    }
+
+    for (auto& [id, participant] : _participants) {
+        {
+            std::lock_guard<std::mutex> jitterLock(participant->jitterMutex);
+            participant->jitter.Pop(participant->frame.data());
+        }
+        _inputs.push_back(participant->frame.data());
+
+        if (mixMinus) {
+            auto& out = (*mixMinus)[id];
+            out.resize(_frameSamples);
+            _outputs.push_back(out.data());
+        }
+    }
+
+    _mixer.Mix(_inputs, mix.data(), mixMinus ? &_outputs : nullptr);
+}
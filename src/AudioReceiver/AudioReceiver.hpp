@@ -0,0 +1,115 @@
+#pragma once
+
+#include <memory>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "rtc/rtc.hpp"
+
+#include "AudioMixer.hpp"
+#include "JitterBuffer.hpp"
+
+class NoiseSuppressor;
+
+// Forward declaration - opus.h is included in the cpp file
+struct OpusDecoder;
+
+struct OpusDecoderDeleter {
+    void operator()(OpusDecoder* ptr) const noexcept;
+};
+
+// This class is responsible for:
+//  - receiving audio tracks of remote participants from libdatachannel PeerConnections
+//  - decoding incoming Opus RTP packets into int16 mono PCM
+//  - optionally running far-end noise suppression per participant
+//  - jitter buffering every stream and mixing them into one frame per Mix() call,
+//    plus mix-minus frames (everyone except that participant) when requested
+class AudioReceiver {
+public:
+    using PeerConnectionPtr = std::shared_ptr<rtc::PeerConnection>;
+
+    // Media id of the track added by AddParticipant. It differs from the "audio"
+    // mid of AudioSender, so both can live on the same PeerConnection.
+    static constexpr const char* kTrackMid = "audio-recv";
+
+    // sampleRate: mix rate; Opus decodes to 8, 12, 16, 24 or 48kHz only
+    // frameSamples: samples per mixed frame (480 = 10ms at 48kHz)
+    // jitterFrames: frames buffered before a stream starts playing
+    AudioReceiver(unsigned int sampleRate,
+                  size_t frameSamples = 480,
+                  size_t jitterFrames = 4);
+    ~AudioReceiver();
+
+    // Add a receive-only audio track to this connection and receive from it.
+    // Should be called before negotiation, like AudioSender::AttachTrack().
+    void AddParticipant(const std::string& id, PeerConnectionPtr pc, bool denoise);
+
+    // Receive from an existing track, e.g. one the remote side offered
+    // (forward it from your pc->onTrack handler) or a local loopback track.
+    // A participant has one track: attaching another one detaches the previous.
+    void AttachTrack(const std::string& id, std::shared_ptr<rtc::Track> track, bool denoise);
+
+    void RemoveParticipant(const std::string& id);
+
+    // Feed a decoded buffer of a participant directly (synthetic streams).
+    // Unknown ids are registered on the fly. Thread-safe.
+    void OnAudioBuffer(const std::string& id, const int16_t* samples, size_t numSamples);
+
+    // Pull one frame of frameSamples samples from every participant and mix them.
+    // mixMinus, if given, ends up with exactly one frame per current participant id.
+    // Typically called from the playout thread every frame period.
+    void Mix(std::vector<int16_t>& mix,
+             std::map<std::string, std::vector<int16_t>>* mixMinus = nullptr);
+
+    unsigned int GetSampleRate() const { return _sampleRate; }
+    size_t GetFrameSamples() const { return _frameSamples; }
+
+private:
+    struct Participant {
+        Participant(unsigned int sampleRate, size_t frameSamples, size_t jitterFrames);
+        ~Participant();
+
+        // Decode one RTP packet and Push() the PCM; broken packets are dropped
+        void Receive(const rtc::binary& packet);
+
+        // Denoise (if enabled) outside the jitter lock, then queue the result
+        void Push(const int16_t* samples, size_t numSamples);
+        // Same, with processMutex already held
+        void PushLocked(const int16_t* samples, size_t numSamples);
+
+        unsigned int sampleRate;
+
+        // Guards decoder, suppressor and their buffers; held while decoding / denoising
+        std::mutex processMutex;
+        std::unique_ptr<OpusDecoder, OpusDecoderDeleter> decoder;
+        std::vector<int16_t> decoded;
+        std::unique_ptr<NoiseSuppressor> suppressor;
+        std::vector<int16_t> processed;
+
+        // Guards jitter; held only for the queue operations, so Mix() never waits for RNNoise
+        std::mutex jitterMutex;
+        JitterBuffer jitter;
+
+        std::shared_ptr<rtc::Track> track;  // guarded by AudioReceiver::_participantsMutex
+        std::vector<int16_t> frame;         // written by Mix() only
+    };
+
+    std::shared_ptr<Participant> GetOrCreate(const std::string& id);
+
+    // Remove our message handler from a track we attached earlier
+    static void Detach(const std::shared_ptr<rtc::Track>& track);
+
+    unsigned int _sampleRate;
+    size_t _frameSamples;
+    size_t _jitterFrames;
+
+    std::mutex _participantsMutex;
+    std::map<std::string, std::shared_ptr<Participant>> _participants;
+
+    AudioMixer _mixer;
+    std::vector<const int16_t*> _inputs;
+    std::vector<int16_t*> _outputs;
+};
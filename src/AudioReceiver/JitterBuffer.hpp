@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Fixed-capacity PCM ring buffer that smooths out network jitter for one stream.
+// Playback starts only after targetFrames frames are buffered; on underrun it
+// outputs silence and buffers up to targetFrames again. When more than maxFrames
+// are queued the oldest samples are dropped to bound latency.
+// Not thread-safe: the owner synchronizes Push / Pop.
+class JitterBuffer {
+public:
+    JitterBuffer(size_t frameSamples, size_t targetFrames, size_t maxFrames)
+        : _frameSamples(frameSamples)
+        , _targetSamples(frameSamples * targetFrames)
+        , _ring(frameSamples * (maxFrames > targetFrames ? maxFrames : targetFrames + 1)) {}
+
+    void Push(const int16_t* samples, size_t numSamples) {
+        for (size_t i = 0; i < numSamples; ++i) {
+            if (_size == _ring.size()) {
+                // Drop the oldest sample
+                _read = (_read + 1) % _ring.size();
+                --_size;
+                ++_droppedSamples;
+            }
+            _ring[(_read + _size) % _ring.size()] = samples[i];
+            ++_size;
+        }
+        if (_buffering && _size >= _targetSamples) {
+            _buffering = false;
+        }
+    }
+
+    // Writes exactly frameSamples samples; returns false (silence written) while buffering
+    bool Pop(int16_t* out) {
+        if (!_buffering && _size < _frameSamples) {
+            _buffering = true;
+            ++_underruns;
+        }
+        if (_buffering) {
+            for (size_t i = 0; i < _frameSamples; ++i) out[i] = 0;
+            return false;
+        }
+        for (size_t i = 0; i < _frameSamples; ++i) {
+            out[i] = _ring[_read];
+            _read = (_read + 1) % _ring.size();
+        }
+        _size -= _frameSamples;
+        return true;
+    }
+
+    size_t Available() const { return _size; }
+    uint64_t Underruns() const { return _underruns; }
+    uint64_t DroppedSamples() const { return _droppedSamples; }
+
+private:
+    size_t _frameSamples;
+    size_t _targetSamples;
+    std::vector<int16_t> _ring;
+    size_t _read = 0;
+    size_t _size = 0;
+    bool _buffering = true;
+    uint64_t _underruns = 0;
+    uint64_t _droppedSamples = 0;
+};
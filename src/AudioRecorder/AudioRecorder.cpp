@@ -1,25 +1,51 @@
 #include "RtAudio.h"
 #include "AudioRecorder.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <cstring>
+#include <chrono>
 
 // callback для rtaudio — only records raw data into RecordData
 int record(void *outputBuffer, void *inputBuffer, unsigned int nBufferFrames,
            double streamTime, RtAudioStreamStatus status, void *userData)
 {
     RecordData* data = static_cast<RecordData*>(userData);
+    const auto callbackStart = std::chrono::steady_clock::now();
+
+    if (!data->firstBufferSeen.load(std::memory_order_relaxed)) {
+        data->firstBufferAt = callbackStart;
+        data->firstBufferSeen.store(true, std::memory_order_release);
+    }
+
+    // First buffer on this thread: apply scheduling / affinity settings
+    if (!data->realtimeApplied.exchange(true)) {
+        data->threadReport = ApplyThreadConfig(data->realtime);
+    }
 
     if (status) {
         std::cout << "Stream overflow detected!" << std::endl;
     }
 
     if (data->isRecording && inputBuffer) {
-        int16_t* inputSamples = static_cast<int16_t*>(inputBuffer);
+        const int16_t* inputSamples = static_cast<const int16_t*>(inputBuffer);
+
+        if (data->floatInput) {
+            // Everything downstream is int16; resize only if the driver hands
+            // us a larger buffer than it granted at open time
+            if (data->convertBuffer.size() < nBufferFrames) {
+                data->convertBuffer.resize(nBufferFrames);
+            }
+            const float* floatSamples = static_cast<const float*>(inputBuffer);
+            for (unsigned int i = 0; i < nBufferFrames; ++i) {
+                const float clamped = std::min(1.0f, std::max(-1.0f, floatSamples[i]));
+                data->convertBuffer[i] = static_cast<int16_t>(std::lrint(clamped * 32767.0f));
+            }
+            inputSamples = data->convertBuffer.data();
+        }
 
         // Always store the raw samples locally
-        data->audioData.insert(data->audioData.end(),
-                               inputSamples,
-                               inputSamples + nBufferFrames);
+        data->audioData.Append(inputSamples, nBufferFrames);
 
         // Optionally forward the buffer to an external consumer (e.g. AudioSender)
         if (data->onBuffer) {
@@ -32,24 +58,211 @@ int record(void *outputBuffer, void *inputBuffer, unsigned int nBufferFrames,
         }
     }
 
+    // Lateness is the gap since the previous callback beyond one buffer period.
+    // It includes wake-up latency, which is what realtime scheduling affects.
+    // More than half a period late (or a driver overflow) counts as a deadline miss.
+    const double period = static_cast<double>(nBufferFrames) / data->sampleRate;
+    bool missed = status != 0;
+    if (data->hasLastCallback) {
+        const double lateness =
+            std::chrono::duration<double>(callbackStart - data->lastCallbackAt).count() - period;
+        const int64_t latenessUs = static_cast<int64_t>(lateness * 1e6);
+        if (latenessUs > data->maxLatenessUs.load(std::memory_order_relaxed)) {
+            data->maxLatenessUs.store(latenessUs, std::memory_order_relaxed);
+        }
+        missed = missed || lateness > period / 2;
+    }
+    data->lastCallbackAt = callbackStart;
+    data->hasLastCallback = true;
+
+    data->callbacks.fetch_add(1, std::memory_order_relaxed);
+    if (missed) {
+        data->deadlineMisses.fetch_add(1, std::memory_order_relaxed);
+    }
+
     return 0;
 }
 
+namespace {
+
+// The callback turns FLOAT32 into int16 and stores SINT16 as is; 0 means "not specified"
+bool IsSupportedFormat(RtAudioFormat format) {
+    return format == 0 || format == RTAUDIO_SINT16 || format == RTAUDIO_FLOAT32;
+}
+
+} // namespace
+
 AudioRecorder::AudioRecorder(std::shared_ptr<ISavingWorker> saving_worker)
-    : _is_recording(false)
-    , _buffer_frames(512)
-    , _saving_worker(saving_worker) {
+    : AudioRecorder(std::move(saving_worker), AudioDeviceSettings()) {
+}
+
+AudioRecorder::AudioRecorder(std::shared_ptr<ISavingWorker> saving_worker, const AudioDeviceSettings& settings)
+    : _saving_worker(saving_worker)
+    , _is_recording(false)
+    , _buffer_frames(settings.bufferFrames)
+    , _settings(settings)
+    , _created_at(std::chrono::steady_clock::now()) {
+    _record_data.sampleRate = settings.sampleRate ? settings.sampleRate : 44100;
+    _record_data.isRecording = false;
+
+    switch (settings.openMode) {
+    case AudioDeviceSettings::OpenMode::Eager:
+        Open();
+        break;
+    case AudioDeviceSettings::OpenMode::Background:
+        _open_future = std::async(std::launch::async, [this] { OpenStream(); });
+        break;
+    case AudioDeviceSettings::OpenMode::Lazy:
+        break;
+    }
+}
+
+AudioRecorder::~AudioRecorder() {
+    if (_open_future.valid()) {
+        try {
+            _open_future.get();
+        } catch (const std::exception&) {
+            // Nothing to clean up if the background open failed
+        }
+    }
+    if (_audio && _audio->isStreamOpen()) {
+        _audio->closeStream();
+    }
+}
+
+void AudioRecorder::Open() {
+    if (_open_future.valid()) {
+        // Background open in flight: wait for it and rethrow its error, if any
+        _open_future.get();
+    }
+    if (!_audio || !_audio->isStreamOpen()) {
+        OpenStream();
+    }
+    // On the caller's thread, so the worker is never touched by a background open
+    if (_saving_worker) {
+        _saving_worker->SetSampleRate(_record_data.sampleRate);
+    }
+}
+
+void AudioRecorder::WaitForOpen() const {
+    if (_open_future.valid()) {
+        _open_future.wait();
+    }
+}
+
+bool AudioRecorder::TryOpen(const DeviceProbeResult& probe) {
+    _parameters.deviceId = probe.deviceId;
+    _parameters.nChannels = 1;
+    _parameters.firstChannel = 0;
+    // The callback reads these, so they have to be set before the stream exists
+    _record_data.sampleRate = probe.sampleRate;
+    _record_data.floatInput = probe.format == RTAUDIO_FLOAT32;
+
+    // probe.bufferFrames stays the requested size (that is what the cache is
+    // matched on); the driver may grant a different one
+    unsigned int bufferFrames = probe.bufferFrames ? probe.bufferFrames : _settings.bufferFrames;
+    if (_audio->openStream(NULL, &_parameters, probe.format,
+                          probe.sampleRate, &bufferFrames, &record, &_record_data)) {
+        return false;
+    }
+    _buffer_frames = bufferFrames;
+    _record_data.convertBuffer.assign(_record_data.floatInput ? bufferFrames : 0, 0);
+    return true;
+}
+
+void AudioRecorder::OpenStream() {
+    const auto start = std::chrono::steady_clock::now();
+    if (!_audio) {
+        // Created here rather than with the recorder: RtAudio enumerates the
+        // devices of its default API on construction, which Lazy and Background
+        // modes are meant to keep off the constructing thread
+        _audio = std::make_unique<RtAudio>();
+    }
+
+    DeviceProbeCache cache(_settings.cachePath);
+    const bool useCache = _settings.useCache && cache.IsEnabled();
+    DeviceProbeResult probe;
+    std::vector<unsigned int> deviceIds;
+    bool opened = false;
+
+    if (!IsSupportedFormat(_settings.format)) {
+        throw std::runtime_error("Unsupported input format: only RTAUDIO_SINT16 and RTAUDIO_FLOAT32 can be recorded");
+    }
+
+    if (_settings.deviceId && _settings.sampleRate && _settings.format) {
+        // Everything specified explicitly: nothing to enumerate beyond what RtAudio did on construction
+        probe.deviceId = _settings.deviceId;
+        probe.sampleRate = _settings.sampleRate;
+        probe.format = _settings.format;
+        probe.bufferFrames = _settings.bufferFrames;
+        if (!TryOpen(probe)) {
+            std::cout << "Error opening stream: " << _audio->getErrorText() << std::endl;
+            throw std::runtime_error("Error opening stream with the specified device settings");
+        }
+        _stream_source = "explicit";
+        opened = true;
+    } else if (useCache) {
+        // Key the cache on the OS device list, which opens no device. Only where
+        // there is none (Windows) does the key need an RtAudio enumeration.
+        if (!DeviceProbeCache::SystemSignature(probe.signature)) {
+            deviceIds = _audio->getDeviceIds();
+            probe.signature = DeviceProbeCache::Signature(*_audio, deviceIds);
+        }
+
+        // Open the cached device straight away; getDeviceInfo() only reads the
+        // list RtAudio built on construction, so the name check costs no probe
+        DeviceProbeResult cached;
+        if (cache.Load(probe.signature, cached)
+            && IsSupportedFormat(cached.format)
+            && cached.bufferFrames == _settings.bufferFrames
+            && (!_settings.deviceId || _settings.deviceId == cached.deviceId)
+            && (!_settings.sampleRate || _settings.sampleRate == cached.sampleRate)
+            && (!_settings.format || _settings.format == cached.format)) {
+            if (_audio->getDeviceInfo(cached.deviceId).name == cached.deviceName && TryOpen(cached)) {
+                probe = cached;
+                _stream_source = "cache";
+                opened = true;
+            } else {
+                std::cout << "Cached input device is not available (" << _audio->getErrorText()
+                          << "), probing devices..." << std::endl;
+                cache.Invalidate();
+            }
+        }
+    }
+
+    if (!opened) {
+        // Re-probe only now that the cache could not be used
+        if (deviceIds.empty()) {
+            deviceIds = _audio->getDeviceIds();
+        }
+        ProbeAndOpen(probe, deviceIds);
+        _stream_source = "probe";
+        if (useCache && !cache.Store(probe)) {
+            std::cout << "Could not write device cache: " << cache.GetPath() << std::endl;
+        }
+    }
+
+    _record_data.sampleRate = probe.sampleRate;
+    _open_duration = std::chrono::steady_clock::now() - start;
+}
+
+void AudioRecorder::ProbeAndOpen(DeviceProbeResult& probe, const std::vector<unsigned int>& deviceIds) {
     bool streamOpened = false;
 
-    std::vector<unsigned int> deviceIds = _audio.getDeviceIds();
     if (deviceIds.size() < 1) {
         std::cout << "\nNo audio devices found!\n";
         throw std::runtime_error("No audio devices found");
     }
 
+    // getDeviceInfo() reads the list probed by getDeviceIds(), so the default
+    // input is picked from it instead of asking RtAudio (and re-probing) again
+    unsigned int defaultInput = 0;
     std::cout << "Available audio devices:" << std::endl;
     for (unsigned int i = 0; i < deviceIds.size(); i++) {
-        RtAudio::DeviceInfo info = _audio.getDeviceInfo(deviceIds[i]);
+        RtAudio::DeviceInfo info = _audio->getDeviceInfo(deviceIds[i]);
+        if (info.isDefaultInput && !defaultInput) {
+            defaultInput = deviceIds[i];
+        }
         std::cout << "Device " << i << " (ID: " << deviceIds[i] << "): " << info.name << std::endl;
         std::cout << "  Input channels: " << info.inputChannels << std::endl;
         if (info.inputChannels > 0) {
@@ -61,16 +274,20 @@ AudioRecorder::AudioRecorder(std::shared_ptr<ISavingWorker> saving_worker)
         }
     }
 
-    unsigned int defaultDevice = _audio.getDefaultInputDevice();
-    RtAudio::DeviceInfo defaultInfo = _audio.getDeviceInfo(defaultDevice);
+    if (!defaultInput) {
+        defaultInput = _audio->getDefaultInputDevice();
+    }
+    unsigned int defaultDevice = _settings.deviceId ? _settings.deviceId : defaultInput;
+    RtAudio::DeviceInfo defaultInfo = _audio->getDeviceInfo(defaultDevice);
 
-    std::cout << "\nUsing default input device: " << defaultInfo.name << std::endl;
+    std::cout << "\nUsing " << (_settings.deviceId ? "requested" : "default")
+              << " input device: " << defaultInfo.name << std::endl;
     std::cout << "Input channels: " << defaultInfo.inputChannels << std::endl;
 
     if (defaultInfo.inputChannels < 1) {
-        std::cout << "Default device has no input channels! Searching for alternative..." << std::endl;
+        std::cout << "Device has no input channels! Searching for alternative..." << std::endl;
         for (unsigned int i = 0; i < deviceIds.size(); i++) {
-            RtAudio::DeviceInfo info = _audio.getDeviceInfo(deviceIds[i]);
+            RtAudio::DeviceInfo info = _audio->getDeviceInfo(deviceIds[i]);
             if (info.inputChannels > 0) {
                 defaultDevice = deviceIds[i];
                 defaultInfo = info;
@@ -88,7 +305,7 @@ AudioRecorder::AudioRecorder(std::shared_ptr<ISavingWorker> saving_worker)
     std::cout << "Preferred sample rate: " << defaultInfo.preferredSampleRate << std::endl;
 
     // самая популярная типа
-    unsigned int sampleRate = 44100;
+    unsigned int sampleRate = _settings.sampleRate ? _settings.sampleRate : 44100;
 
     // Проверяем поддерживается ли 44100
     bool sampleRateSupported = false;
@@ -102,45 +319,38 @@ AudioRecorder::AudioRecorder(std::shared_ptr<ISavingWorker> saving_worker)
     // Если 44100 не поддерживается, используем то, что хочетустройство
     if (!sampleRateSupported) {
         sampleRate = defaultInfo.preferredSampleRate;
-        std::cout << "44100 not supported, using preferred rate: " << sampleRate << std::endl;
+        std::cout << "Requested rate not supported, using preferred rate: " << sampleRate << std::endl;
     }
 
-    // Создаем структуру для передачи данных
-    _record_data.sampleRate = sampleRate;
-    _record_data.isRecording = false;
-
-    
-    _parameters.deviceId = defaultDevice;
-    _parameters.nChannels = 1;
-    _parameters.firstChannel = 0;
-
-    unsigned int bufferFrames = 256;
+    probe.deviceId = defaultDevice;
+    probe.deviceName = defaultInfo.name;
+    probe.sampleRate = sampleRate;
+    probe.format = _settings.format ? _settings.format : RTAUDIO_SINT16;
+    probe.bufferFrames = _settings.bufferFrames;
 
     std::cout << "\nTrying to open stream with:" << std::endl;
     std::cout << "  Sample rate: " << sampleRate << std::endl;
-    std::cout << "  Buffer frames: " << bufferFrames << std::endl;
-    std::cout << "  Format: SINT16" << std::endl;
+    std::cout << "  Buffer frames: " << probe.bufferFrames << std::endl;
+    std::cout << "  Format: " << (probe.format == RTAUDIO_FLOAT32 ? "FLOAT32" : "SINT16") << std::endl;
 
     // тут пипец
-    if (_audio.openStream(NULL, &_parameters, RTAUDIO_SINT16,
-                       sampleRate, &bufferFrames, &record, &_record_data)) {
-        std::cout << "Error opening stream: " << _audio.getErrorText() << std::endl;
+    if (!TryOpen(probe)) {
+        std::cout << "Error opening stream: " << _audio->getErrorText() << std::endl;
 
         // Пробуем другие форматы если SINT16 не работает
         std::cout << "Trying FLOAT32 format..." << std::endl;
-        if (_audio.openStream(NULL, &_parameters, RTAUDIO_FLOAT32,
-                           sampleRate, &bufferFrames, &record, &_record_data)) {
-            std::cout << "Error with FLOAT32: " << _audio.getErrorText() << std::endl;
+        probe.format = RTAUDIO_FLOAT32;
+        if (!TryOpen(probe)) {
+            std::cout << "Error with FLOAT32: " << _audio->getErrorText() << std::endl;
 
             // Пробуем другую частоту дискретизации
             std::cout << "Trying sample rate 48000..." << std::endl;
-            if (_audio.openStream(NULL, &_parameters, RTAUDIO_SINT16,
-                               48000, &bufferFrames, &record, &_record_data)) {
-                std::cout << "All attempts failed: " << _audio.getErrorText() << std::endl;
+            probe.format = RTAUDIO_SINT16;
+            probe.sampleRate = 48000;
+            if (!TryOpen(probe)) {
+                std::cout << "All attempts failed: " << _audio->getErrorText() << std::endl;
                 throw std::runtime_error("Error opening stream, all sample rates failed");
             } else {
-                sampleRate = 48000;
-                _record_data.sampleRate = sampleRate;
                 std::cout << "Success with 48000 SINT16!" << std::endl;
                 streamOpened = true;
             }
@@ -149,7 +359,7 @@ AudioRecorder::AudioRecorder(std::shared_ptr<ISavingWorker> saving_worker)
             streamOpened = true;
         }
     } else {
-        std::cout << "Stream opened successfully with SINT16!" << std::endl;
+        std::cout << "Stream opened successfully!" << std::endl;
         streamOpened = true;
     }
 
@@ -157,26 +367,68 @@ AudioRecorder::AudioRecorder(std::shared_ptr<ISavingWorker> saving_worker)
         std::cout << "Failed to open audio stream!" << std::endl;
         throw std::runtime_error("Failed to open audio stream!");
     }
-    _saving_worker->SetSampleRate(sampleRate);
 }
 
-AudioRecorder::~AudioRecorder() {
-    if (_audio.isStreamOpen()) {
-        _audio.closeStream();
+double AudioRecorder::GetTimeToFirstBufferMs() const {
+    if (!_record_data.firstBufferSeen.load(std::memory_order_acquire)) {
+        return -1.0;
     }
+    return std::chrono::duration<double, std::milli>(_record_data.firstBufferAt - _created_at).count();
+}
+
+double AudioRecorder::GetOpenDurationMs() const {
+    WaitForOpen();
+    return std::chrono::duration<double, std::milli>(_open_duration).count();
+}
+
+void AudioRecorder::SetRealtimeConfig(const RealtimeConfig& config) {
+    _record_data.realtime = config;
+    _memory_details.clear();
+    if (config.lockMemory) {
+        LockProcessMemory(_memory_details);
+    } else if (IsProcessMemoryLocked()) {
+        // The lock is process-wide and outlives the recorder that set it:
+        // mlockall(MCL_FUTURE) stays in effect until explicitly undone
+        UnlockProcessMemory(_memory_details);
+    }
+}
+
+RealtimeReport AudioRecorder::GetRealtimeReport() const {
+    RealtimeReport report = _record_data.threadReport;
+    report.memoryLocked = IsProcessMemoryLocked();
+    if (!_memory_details.empty()) {
+        report.details += (report.details.empty() ? "" : "; ") + _memory_details;
+    }
+    return report;
 }
 
 void AudioRecorder::Record(unsigned int milliseconds) {
-    _record_data.audioData.clear();
+    // Lazy / background modes open the stream here at the latest
+    Open();
+
+    _record_data.audioData.Clear();
+    _recording = AudioBuffer();
+    _record_data.callbacks = 0;
+    _record_data.deadlineMisses = 0;
+    _record_data.maxLatenessUs = 0;
+    _record_data.hasLastCallback = false;
+    _record_data.realtimeApplied = false;
+
+    // Pre-fault the whole recording so the callback never reallocates
+    if (_record_data.realtime.prefault) {
+        const size_t expected = static_cast<size_t>(milliseconds) * _record_data.sampleRate / 1000
+                                + _buffer_frames;
+        _record_data.audioData.Reserve(expected);
+    }
     _record_data.isRecording = true;
 
     std::cout << "\n=== Starting recording ===" << std::endl;
     std::cout << "Recording";
 
-    if (_audio.startStream()) {
-        std::cout << "Error starting stream: " << _audio.getErrorText() << std::endl;
-        if (_audio.isStreamOpen()) {
-            _audio.closeStream();
+    if (_audio->startStream()) {
+        std::cout << "Error starting stream: " << _audio->getErrorText() << std::endl;
+        if (_audio->isStreamOpen()) {
+            _audio->closeStream();
         }
         return;
     }
@@ -188,17 +440,27 @@ void AudioRecorder::Record(unsigned int milliseconds) {
     _record_data.isRecording = false;
 
     // Останавливаем поток
-    if (_audio.isStreamRunning()) {
-        _audio.stopStream();
+    if (_audio->isStreamRunning()) {
+        _audio->stopStream();
     }
 
     std::cout << std::endl;
     std::cout << "Recording stopped." << std::endl;
-    std::cout << "Recorded " << _record_data.audioData.size() << " samples ("
-              << (double)_record_data.audioData.size() << " seconds)" << std::endl;
+    _recording = _record_data.audioData.Build();
+
+    std::cout << "Recorded " << _recording.Size() << " samples ("
+              << (double)_recording.Size() << " seconds)" << std::endl;
+    std::cout << "Time to first buffer: " << GetTimeToFirstBufferMs() << " ms (stream open: "
+              << GetOpenDurationMs() << " ms, " << _stream_source << ")" << std::endl;
+    std::cout << "Callbacks: " << _record_data.callbacks
+              << ", deadline misses: " << _record_data.deadlineMisses
+              << ", max lateness: " << GetMaxLatenessMs() << " ms" << std::endl;
+    if (!GetRealtimeReport().details.empty()) {
+        std::cout << "Realtime: " << GetRealtimeReport().details << std::endl;
+    }
 
     // Проверяем, есть ли данные
-    if (_record_data.audioData.empty()) {
+    if (_recording.Empty()) {
         std::cout << "WARNING: No audio data was recorded!" << std::endl;
         std::cout << "Possible issues:" << std::endl;
         std::cout << "1. Microphone permissions not granted" << std::endl;
@@ -209,12 +471,13 @@ void AudioRecorder::Record(unsigned int milliseconds) {
         std::cout << "Saving to file: "  << "..." << std::endl;
     }
     // Закрываем поток
-    if (_audio.isStreamOpen()) {
-        _audio.closeStream();
+    if (_audio->isStreamOpen()) {
+        _audio->closeStream();
     }
-    std::cout << "setting data..." << _record_data.audioData.size() << std::endl;
+    std::cout << "setting data..." << _recording.Size() << std::endl;
 
-    _saving_worker->SetAudioData(_record_data.audioData);
+    // Shared with the worker, not copied
+    _saving_worker->SetAudioData(_recording);
 
 }
 
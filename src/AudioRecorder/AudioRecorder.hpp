@@ -10,35 +10,96 @@
 #include <thread>
 #include <cstdlib>
 #include <cstring>
+#include <chrono>
+#include <future>
 
 #include "RecordData.hpp"
+#include "RealtimeConfig.hpp"
+#include "AudioBuffer.hpp"
+#include "DeviceProbeCache.hpp"
 #include "../SavingWorkers/ISavingWorker.hpp"
 
+// How AudioRecorder picks and opens its input stream.
+// Zero values mean "choose automatically" (cached probe, then full probe).
+// With deviceId, sampleRate and format all set no probing happens at all.
+struct AudioDeviceSettings {
+    enum class OpenMode {
+        Eager,      // open in the constructor (previous behaviour)
+        Lazy,       // open on Open() or the first Record()
+        Background  // start opening in the constructor on another thread
+    };
+
+    unsigned int deviceId = 0;
+    unsigned int sampleRate = 0;
+    RtAudioFormat format = 0;
+    unsigned int bufferFrames = 256;
+    OpenMode openMode = OpenMode::Eager;
+    bool useCache = true;
+    std::string cachePath;  // empty -> DeviceProbeCache default location
+};
+
 class AudioRecorder {
 public:
     AudioRecorder(std::shared_ptr<ISavingWorker> saving_worker);
+    AudioRecorder(std::shared_ptr<ISavingWorker> saving_worker, const AudioDeviceSettings& settings);
     ~AudioRecorder();
 
+    // Make sure the stream is open (waits for a background open). Throws on failure.
+    void Open();
+
     void Record(unsigned int milliseconds);
     bool SaveData();
 
-    // Access recorded data for external processing 
-    const std::vector<int16_t>& GetAudioData() const { return _record_data.audioData; }
-    unsigned int GetSampleRate() const { return _record_data.sampleRate; }
+    // Access recorded data for external processing (shared, not copied)
+    const AudioBuffer& GetAudioData() const { return _recording; }
+    // Parameters of the opened stream. While a Background open is running these
+    // wait for it (its error, if any, is rethrown by Open() / Record())
+    unsigned int GetSampleRate() const { WaitForOpen(); return _record_data.sampleRate; }
+    unsigned int GetBufferFrames() const { WaitForOpen(); return _buffer_frames; }
 
     // Set a per-buffer capture callback (called from the audio callback thread).
     // The callback receives: (samples, numSamples, sampleRate).
     void SetOnBufferCallback(std::function<void(const int16_t*, size_t, unsigned int)> cb) {
         _record_data.onBuffer = std::move(cb);
     }
+
+    // Scheduling / affinity for the capture thread, memory locking and pre-faulting.
+    // Memory is locked immediately, the rest is applied on the next Record().
+    void SetRealtimeConfig(const RealtimeConfig& config);
+    // What was actually applied (valid after Record())
+    RealtimeReport GetRealtimeReport() const;
+
+    // Callback statistics of the last Record()
+    uint64_t GetCallbackCount() const { return _record_data.callbacks; }
+    uint64_t GetDeadlineMisses() const { return _record_data.deadlineMisses; }
+    double GetMaxLatenessMs() const { return _record_data.maxLatenessUs / 1000.0; }
+
+    // Startup timings: construction -> first captured buffer (-1 if none yet),
+    // and how long opening the stream took
+    double GetTimeToFirstBufferMs() const;
+    double GetOpenDurationMs() const;
     
 private:
+    void OpenStream();
+    // Full enumeration with the SINT16 / FLOAT32 / 48000 fallback ladder
+    void ProbeAndOpen(DeviceProbeResult& probe, const std::vector<unsigned int>& deviceIds);
+    bool TryOpen(const DeviceProbeResult& probe);
+    // Block until a Background open has finished; its writes are visible afterwards
+    void WaitForOpen() const;
+
     RecordData _record_data;
-    RtAudio _audio;
+    AudioBuffer _recording;
+    std::unique_ptr<RtAudio> _audio;  // created by OpenStream()
     RtAudio::StreamParameters _parameters;
     std::shared_ptr<ISavingWorker> _saving_worker;
     std::atomic<bool> _is_recording;
     unsigned int _buffer_frames;
+    AudioDeviceSettings _settings;
+    std::future<void> _open_future;
+    std::chrono::steady_clock::time_point _created_at;
+    std::chrono::steady_clock::duration _open_duration{};
+    std::string _stream_source = "not opened";
+    std::string _memory_details;
 
 };
 
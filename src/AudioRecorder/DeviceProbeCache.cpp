@@ -0,0 +1,208 @@
+#include "DeviceProbeCache.hpp"
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <system_error>
+
+#if defined(__APPLE__)
+#include <CoreAudio/CoreAudio.h>
+#endif
+
+namespace {
+
+// FNV-1a, stable between runs unlike std::hash
+void HashBytes(uint64_t& hash, const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+}
+
+// Per-user cache directory: $XDG_CACHE_HOME, $HOME/.cache or %LOCALAPPDATA%.
+// Empty if none is set; the shared temp dir is deliberately not used.
+std::filesystem::path UserCacheDir() {
+    if (const char* xdg = std::getenv("XDG_CACHE_HOME"); xdg && *xdg) {
+        return std::filesystem::path(xdg);
+    }
+    if (const char* home = std::getenv("HOME"); home && *home) {
+        return std::filesystem::path(home) / ".cache";
+    }
+    if (const char* localAppData = std::getenv("LOCALAPPDATA"); localAppData && *localAppData) {
+        return std::filesystem::path(localAppData);
+    }
+    return {};
+}
+
+// Hashes a whole file; false if it cannot be read
+bool HashFile(uint64_t& hash, const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return false;
+    }
+    const std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    HashBytes(hash, content.data(), content.size());
+    return true;
+}
+
+} // namespace
+
+DeviceProbeCache::DeviceProbeCache(std::string path)
+    : _path(std::move(path)) {
+    if (_path.empty()) {
+        const std::filesystem::path dir = UserCacheDir();
+        if (!dir.empty()) {
+            _path = (dir / "noise_suppression" / "devices.cache").string();
+        }
+    }
+}
+
+bool DeviceProbeCache::SystemSignature(uint64_t& signature) {
+    uint64_t hash = 14695981039346656037ull;
+#if defined(__linux__)
+    // Kernel lists of cards and PCM devices (with their capture capability),
+    // plus the ALSA configs that pick the default device. Reading them opens nothing.
+    if (!HashFile(hash, "/proc/asound/pcm")) {
+        return false;
+    }
+    HashFile(hash, "/proc/asound/cards");
+    HashFile(hash, "/etc/asound.conf");
+    if (const char* home = std::getenv("HOME"); home && *home) {
+        HashFile(hash, std::string(home) + "/.asoundrc");
+    }
+    signature = hash;
+    return true;
+#elif defined(__APPLE__)
+    // HAL object ids of all devices and the default input; no device is started
+    AudioObjectPropertyAddress address = {kAudioHardwarePropertyDevices,
+                                          kAudioObjectPropertyScopeGlobal,
+                                          0 /* main element */};
+    UInt32 size = 0;
+    if (AudioObjectGetPropertyDataSize(kAudioObjectSystemObject, &address, 0, nullptr, &size) != noErr) {
+        return false;
+    }
+    std::vector<AudioObjectID> devices(size / sizeof(AudioObjectID));
+    if (!devices.empty()
+        && AudioObjectGetPropertyData(kAudioObjectSystemObject, &address, 0, nullptr, &size, devices.data()) != noErr) {
+        return false;
+    }
+    HashBytes(hash, devices.data(), devices.size() * sizeof(AudioObjectID));
+
+    AudioObjectID defaultInput = kAudioObjectUnknown;
+    size = sizeof(defaultInput);
+    address.mSelector = kAudioHardwarePropertyDefaultInputDevice;
+    if (AudioObjectGetPropertyData(kAudioObjectSystemObject, &address, 0, nullptr, &size, &defaultInput) != noErr) {
+        return false;
+    }
+    HashBytes(hash, &defaultInput, sizeof(defaultInput));
+    signature = hash;
+    return true;
+#else
+    (void)hash;
+    return false;
+#endif
+}
+
+uint64_t DeviceProbeCache::Signature(RtAudio& audio, const std::vector<unsigned int>& deviceIds) {
+    // getDeviceInfo() answers from the list the caller's getDeviceIds() probed,
+    // unlike getDeviceNames() / getDefaultInputDevice() which may probe again
+    uint64_t hash = 14695981039346656037ull;
+    for (unsigned int id : deviceIds) {
+        const RtAudio::DeviceInfo info = audio.getDeviceInfo(id);
+        const unsigned char isDefaultInput = info.isDefaultInput ? 1 : 0;
+        HashBytes(hash, &id, sizeof(id));
+        HashBytes(hash, info.name.data(), info.name.size() + 1);
+        HashBytes(hash, &isDefaultInput, sizeof(isDefaultInput));
+    }
+    return hash;
+}
+
+bool DeviceProbeCache::Load(uint64_t signature, DeviceProbeResult& result) const {
+    if (_path.empty()) {
+        return false;
+    }
+    std::ifstream in(_path);
+    if (!in) {
+        return false;
+    }
+
+    std::map<std::string, std::string> values;
+    std::string line;
+    while (std::getline(in, line)) {
+        const size_t eq = line.find('=');
+        if (eq == std::string::npos) continue;
+        values[line.substr(0, eq)] = line.substr(eq + 1);
+    }
+
+    for (const char* key : {"signature", "device", "name", "rate", "format", "buffer"}) {
+        if (values.find(key) == values.end()) {
+            return false;
+        }
+    }
+
+    try {
+        if (std::stoull(values["signature"]) != signature) {
+            return false;
+        }
+        result.signature = signature;
+        result.deviceId = static_cast<unsigned int>(std::stoul(values["device"]));
+        result.deviceName = values["name"];
+        result.sampleRate = static_cast<unsigned int>(std::stoul(values["rate"]));
+        result.format = static_cast<RtAudioFormat>(std::stoul(values["format"]));
+        result.bufferFrames = static_cast<unsigned int>(std::stoul(values["buffer"]));
+    } catch (const std::exception&) {
+        return false;
+    }
+    return result.sampleRate != 0 && result.format != 0;
+}
+
+bool DeviceProbeCache::Store(const DeviceProbeResult& result) const {
+    if (_path.empty()) {
+        return false;
+    }
+    const std::filesystem::path path(_path);
+    std::error_code ec;
+    if (path.has_parent_path()) {
+        std::filesystem::create_directories(path.parent_path(), ec);
+        if (ec) {
+            return false;
+        }
+    }
+
+    // Write a sibling file and rename it over the entry: readers never see a
+    // half-written file, and an existing symlink is replaced, not followed
+    const std::filesystem::path tmp = path.string() + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::trunc);
+        if (!out) {
+            return false;
+        }
+        out << "signature=" << result.signature << "\n"
+            << "device=" << result.deviceId << "\n"
+            << "name=" << result.deviceName << "\n"
+            << "rate=" << result.sampleRate << "\n"
+            << "format=" << result.format << "\n"
+            << "buffer=" << result.bufferFrames << "\n";
+        if (!out.flush()) {
+            std::filesystem::remove(tmp, ec);
+            return false;
+        }
+    }
+    std::filesystem::rename(tmp, path, ec);
+    if (ec) {
+        std::filesystem::remove(tmp, ec);
+        return false;
+    }
+    return true;
+}
+
+void DeviceProbeCache::Invalidate() const {
+    if (_path.empty()) {
+        return;
+    }
+    std::error_code ec;
+    std::filesystem::remove(_path, ec);
+}
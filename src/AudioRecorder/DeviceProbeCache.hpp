@@ -0,0 +1,50 @@
+#pragma once
+
+#include <RtAudio.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Stream parameters that worked last time, keyed by the device list they were probed on
+struct DeviceProbeResult {
+    uint64_t signature = 0;
+    unsigned int deviceId = 0;
+    std::string deviceName;  // RtAudio ids are assigned per run, the name confirms the id
+    unsigned int sampleRate = 0;
+    RtAudioFormat format = 0;
+    unsigned int bufferFrames = 0;
+};
+
+// Small key=value file that lets AudioRecorder skip device enumeration and
+// the openStream fallback ladder on warm starts. The entry is ignored as soon
+// as the device list (ids, names or default input) changes.
+// Changes only a sound server knows about (e.g. a PulseAudio default source)
+// are not part of SystemSignature; delete the file or set useCache = false then.
+class DeviceProbeCache {
+public:
+    // Empty path -> <user cache dir>/noise_suppression/devices.cache, where the
+    // user cache dir is $XDG_CACHE_HOME or $HOME/.cache (%LOCALAPPDATA% on Windows).
+    // Without any of them the cache is disabled: Load/Store just return false.
+    explicit DeviceProbeCache(std::string path = "");
+
+    bool IsEnabled() const { return !_path.empty(); }
+
+    // Fails if there is no file, it is malformed or was probed on other devices
+    bool Load(uint64_t signature, DeviceProbeResult& result) const;
+    bool Store(const DeviceProbeResult& result) const;
+    void Invalidate() const;
+
+    // Hash of the system's audio device list, read without opening or probing any
+    // device (/proc/asound on Linux, the CoreAudio HAL on macOS). False where no
+    // such listing exists; use Signature() there.
+    static bool SystemSignature(uint64_t& signature);
+
+    // Hash of the device ids, names and default input flag. deviceIds is the
+    // caller's getDeviceIds() result, so signing does not enumerate again.
+    static uint64_t Signature(RtAudio& audio, const std::vector<unsigned int>& deviceIds);
+
+    const std::string& GetPath() const { return _path; }
+
+private:
+    std::string _path;
+};
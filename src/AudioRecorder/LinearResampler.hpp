@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Streaming linear-interpolation resampler. The read position and the last
+// input sample are carried across Process() calls, so feeding a signal in
+// chunks gives the same result as one pass: no phase restart or clamping at
+// chunk edges and no per-chunk rounding of the output length.
+// The position is kept as an integer in 1/outputRate input samples, so it
+// never drifts. Changing rates starts a new stream.
+class LinearResampler {
+public:
+    void Reset() { _started = false; }
+
+    // Writes the resampled chunk into output (capacity is reused)
+    void Process(const float* input, size_t numSamples,
+                 unsigned int inputRate, unsigned int outputRate,
+                 std::vector<float>& output) {
+        if (inputRate != _inputRate || outputRate != _outputRate) {
+            _inputRate = inputRate;
+            _outputRate = outputRate;
+            _started = false;
+        }
+        if (numSamples == 0) {
+            output.clear();
+            return;
+        }
+        if (inputRate == outputRate) {
+            output.assign(input, input + numSamples);
+            return;
+        }
+        if (!_started) {
+            _phase = outputRate;  // first output lands exactly on input[0]
+            _last = input[0];
+            _started = true;
+        }
+
+        // Positions are in x where x[0] = _last and x[k] = input[k - 1];
+        // an output at x-index i needs x[i + 1], i.e. i < numSamples
+        const uint64_t end = static_cast<uint64_t>(numSamples) * outputRate;
+        const size_t count = _phase < end ? static_cast<size_t>((end - _phase + inputRate - 1) / inputRate) : 0;
+        output.resize(count);
+
+        const float scale = 1.0f / outputRate;
+        for (size_t k = 0; k < count; ++k) {
+            const size_t index = static_cast<size_t>(_phase / outputRate);
+            const float t = static_cast<float>(_phase % outputRate) * scale;
+            const float a = index == 0 ? _last : input[index - 1];
+            const float b = input[index];
+            output[k] = a + (b - a) * t;
+            _phase += inputRate;
+        }
+
+        _phase -= end;
+        _last = input[numSamples - 1];
+    }
+
+private:
+    unsigned int _inputRate = 0;
+    unsigned int _outputRate = 0;
+    uint64_t _phase = 0;
+    float _last = 0.0f;
+    bool _started = false;
+};
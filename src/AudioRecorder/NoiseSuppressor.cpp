@@ -33,6 +33,26 @@ bool NoiseSuppressor::IsEnabled() const {
     return _enabled;
 }
 
+void NoiseSuppressor::Prefault(size_t maxSamples, unsigned int inputSampleRate) {
+    // Worst case after resampling to 48kHz plus one partially filled frame
+    const size_t resampled = inputSampleRate
+        ? static_cast<size_t>(std::ceil(maxSamples * 48000.0 / inputSampleRate)) + 1
+        : maxSamples;
+    PrefaultVector(_floatInput, maxSamples);
+    PrefaultVector(_resampled48k, resampled);
+    PrefaultVector(_inputBuffer, resampled + 480);
+    PrefaultVector(_processedFrames, resampled + 480);
+    // Output rate is usually the input rate; leave room for rates above 48kHz too
+    PrefaultVector(_resampledOutput, 2 * (std::max(maxSamples, resampled) + 480));
+}
+
+void NoiseSuppressor::SetRealtimeConfig(const RealtimeConfig& config, size_t maxSamples,
+                                        unsigned int inputSampleRate) {
+    if (config.prefault) {
+        Prefault(maxSamples, inputSampleRate);
+    }
+}
+
 void NoiseSuppressor::Int16ToFloat32(const int16_t* input, float* output, size_t count) {
     const float scale = 1.0f / 32768.0f;
     for (size_t i = 0; i < count; ++i) {
@@ -49,31 +69,10 @@ void NoiseSuppressor::Float32ToInt16(const float* input, int16_t* output, size_t
     }
 }
 
-std::vector<float> NoiseSuppressor::Resample(const float* input, size_t inputSamples, 
-                                              unsigned int inputRate, unsigned int outputRate) {
-    if (inputRate == outputRate) {
-        return std::vector<float>(input, input + inputSamples);
-    }
-
-    // Simple linear interpolation resampling
-    const double ratio = static_cast<double>(outputRate) / static_cast<double>(inputRate);
-    const size_t outputSamples = static_cast<size_t>(std::round(inputSamples * ratio));
-    std::vector<float> output(outputSamples);
-
-    for (size_t i = 0; i < outputSamples; ++i) {
-        const double srcIndex = i / ratio;
-        const size_t srcIndex0 = static_cast<size_t>(srcIndex);
-        const size_t srcIndex1 = std::min(srcIndex0 + 1, inputSamples - 1);
-        const double t = srcIndex - srcIndex0;
-
-        if (srcIndex0 < inputSamples) {
-            output[i] = input[srcIndex0] * (1.0 - t) + input[srcIndex1] * t;
-        } else {
-            output[i] = input[inputSamples - 1];
-        }
-    }
-
-    return output;
+void NoiseSuppressor::ResetStream() {
+    _inputResampler.Reset();
+    _outputResampler.Reset();
+    _inputBuffer.clear();
 }
 
 void NoiseSuppressor::ProcessFrame(float* frame) {
@@ -88,40 +87,50 @@ void NoiseSuppressor::ProcessFrame(float* frame) {
 std::vector<int16_t> NoiseSuppressor::ProcessSamples(const int16_t* samples, size_t numSamples,
                                                      unsigned int inputSampleRate, 
                                                      unsigned int outputSampleRate) {
+    std::vector<int16_t> result;
+    ProcessSamples(samples, numSamples, inputSampleRate, outputSampleRate, result);
+    return result;
+}
+
+void NoiseSuppressor::ProcessSamples(const int16_t* samples, size_t numSamples,
+                                     unsigned int inputSampleRate,
+                                     unsigned int outputSampleRate,
+                                     std::vector<int16_t>& output) {
     if (!_enabled || numSamples == 0) {
         // If disabled, just return input samples (may need resampling)
-        if (inputSampleRate != outputSampleRate) {
-            std::vector<float> floatInput(numSamples);
-            Int16ToFloat32(samples, floatInput.data(), numSamples);
-            auto resampled = Resample(floatInput.data(), numSamples, inputSampleRate, outputSampleRate);
-            std::vector<int16_t> result(resampled.size());
-            Float32ToInt16(resampled.data(), result.data(), resampled.size());
-            return result;
+        if (inputSampleRate != outputSampleRate && numSamples > 0) {
+            _floatInput.resize(numSamples);
+            Int16ToFloat32(samples, _floatInput.data(), numSamples);
+            _inputResampler.Process(_floatInput.data(), numSamples, inputSampleRate, outputSampleRate, _resampledOutput);
+            output.resize(_resampledOutput.size());
+            Float32ToInt16(_resampledOutput.data(), output.data(), _resampledOutput.size());
+            return;
         }
-        return std::vector<int16_t>(samples, samples + numSamples);
+        output.assign(samples, samples + numSamples);
+        return;
     }
 
     _currentInputRate = inputSampleRate;
     _currentOutputRate = outputSampleRate;
 
     // Convert int16_t to float32
-    std::vector<float> floatInput(numSamples);
-    Int16ToFloat32(samples, floatInput.data(), numSamples);
+    _floatInput.resize(numSamples);
+    Int16ToFloat32(samples, _floatInput.data(), numSamples);
 
     // Resample to 48kHz if needed (rnnoise requires 48kHz)
-    std::vector<float> resampled48k;
+    const std::vector<float>* input48k = &_floatInput;
     if (inputSampleRate != 48000) {
-        resampled48k = Resample(floatInput.data(), numSamples, inputSampleRate, 48000);
-    } else {
-        resampled48k = std::move(floatInput);
+        _inputResampler.Process(_floatInput.data(), numSamples, inputSampleRate, 48000, _resampled48k);
+        input48k = &_resampled48k;
     }
 
     // Add to input buffer
-    _inputBuffer.insert(_inputBuffer.end(), resampled48k.begin(), resampled48k.end());
+    _inputBuffer.insert(_inputBuffer.end(), input48k->begin(), input48k->end());
 
     // Process complete frames (480 samples each at 48kHz)
     const size_t frameSize = 480;
-    std::vector<float> processedFrames;
+    std::vector<float>& processedFrames = _processedFrames;
+    processedFrames.clear();
     processedFrames.reserve(_inputBuffer.size());
 
     while (_inputBuffer.size() >= frameSize) {
@@ -140,18 +149,33 @@ std::vector<int16_t> NoiseSuppressor::ProcessSamples(const int16_t* samples, siz
     }
 
     // Resample back to output rate if needed
-    std::vector<float> outputFloat;
+    const std::vector<float>* outputFloat = &processedFrames;
     if (outputSampleRate != 48000) {
-        outputFloat = Resample(processedFrames.data(), processedFrames.size(), 48000, outputSampleRate);
-    } else {
-        outputFloat = std::move(processedFrames);
+        _outputResampler.Process(processedFrames.data(), processedFrames.size(), 48000, outputSampleRate, _resampledOutput);
+        outputFloat = &_resampledOutput;
     }
 
     // Convert back to int16_t
-    std::vector<int16_t> result(outputFloat.size());
-    Float32ToInt16(outputFloat.data(), result.data(), outputFloat.size());
-
-    return result;
+    output.resize(outputFloat->size());
+    Float32ToInt16(outputFloat->data(), output.data(), outputFloat->size());
 }
 
+AudioBuffer NoiseSuppressor::ProcessSamples(const AudioBuffer& samples,
+                                            unsigned int inputSampleRate,
+                                            unsigned int outputSampleRate) {
+    if (!_enabled && inputSampleRate == outputSampleRate) {
+        return samples;
+    }
 
+    // A recording is one continuous stream: start from a clean state and let the
+    // resamplers carry their phase across blocks, so block edges leave no seams
+    ResetStream();
+
+    AudioBufferBuilder output;
+    std::vector<int16_t> processed;
+    samples.ForEachBlock([&](const int16_t* block, size_t numSamples) {
+        ProcessSamples(block, numSamples, inputSampleRate, outputSampleRate, processed);
+        output.Append(processed.data(), processed.size());
+    });
+    return output.Build();
+}
@@ -4,6 +4,10 @@
 #include <cstdint>
 #include <memory>
 
+#include "AudioBuffer.hpp"
+#include "RealtimeConfig.hpp"
+#include "LinearResampler.hpp"
+
 // Forward declaration - we'll include rnnoise.h in the cpp file
 struct DenoiseState;
 
@@ -29,6 +33,26 @@ public:
     std::vector<int16_t> ProcessSamples(const int16_t* samples, size_t numSamples, 
                                         unsigned int inputSampleRate, unsigned int outputSampleRate);
 
+    // Same, but writes into the caller's vector so a reused output does not allocate.
+    // All intermediate buffers are members and keep their capacity between calls.
+    void ProcessSamples(const int16_t* samples, size_t numSamples,
+                        unsigned int inputSampleRate, unsigned int outputSampleRate,
+                        std::vector<int16_t>& output);
+
+    // Same for a whole recording, processed block by block as one continuous stream.
+    // Output is written straight into a new buffer; when nothing has to change
+    // (disabled, same rate) the input buffer itself is returned without copying.
+    AudioBuffer ProcessSamples(const AudioBuffer& samples,
+                               unsigned int inputSampleRate, unsigned int outputSampleRate);
+
+    // Reserve and touch internal buffers for calls of up to maxSamples at inputSampleRate,
+    // so that real-time ProcessSamples calls don't page-fault or grow them
+    void Prefault(size_t maxSamples, unsigned int inputSampleRate);
+
+    // Applies the suppressor's part of RealtimeConfig (pre-faulting) for
+    // real-time calls of up to maxSamples at inputSampleRate
+    void SetRealtimeConfig(const RealtimeConfig& config, size_t maxSamples, unsigned int inputSampleRate);
+
 private:
     // Convert int16_t to float32 normalized to [-1.0, 1.0]
     void Int16ToFloat32(const int16_t* input, float* output, size_t count);
@@ -36,9 +60,8 @@ private:
     // Convert float32 normalized to [-1.0, 1.0] to int16_t
     void Float32ToInt16(const float* input, int16_t* output, size_t count);
     
-    // Resample from inputRate to outputRate using linear interpolation
-    std::vector<float> Resample(const float* input, size_t inputSamples, 
-                                unsigned int inputRate, unsigned int outputRate);
+    // Forget resampler phase and buffered samples before an unrelated stream
+    void ResetStream();
     
     // Process a frame of 480 samples (required by rnnoise)
     void ProcessFrame(float* frame);
@@ -48,6 +71,16 @@ private:
     
     // Buffer for accumulating samples until we have a full frame (480 samples at 48kHz)
     std::vector<float> _inputBuffer;
+    // Per-call scratch buffers, reused between calls
+    std::vector<float> _floatInput;
+    std::vector<float> _resampled48k;
+    std::vector<float> _processedFrames;
+    std::vector<float> _resampledOutput;
+
+    // Input rate -> 48kHz (or -> output rate when disabled) and 48kHz -> output rate;
+    // both keep their phase between calls
+    LinearResampler _inputResampler;
+    LinearResampler _outputResampler;
     unsigned int _currentInputRate;
     unsigned int _currentOutputRate;
 };
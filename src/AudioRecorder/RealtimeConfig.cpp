@@ -0,0 +1,114 @@
+#include "RealtimeConfig.hpp"
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+
+#if !defined(_WIN32)
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#endif
+
+namespace {
+
+// mlockall / munlockall act on the whole process, so their state is kept here
+// and not by whoever called them
+std::atomic<bool> processMemoryLocked{false};
+
+void AppendDetail(std::string& details, const std::string& line) {
+    if (!details.empty()) {
+        details += "; ";
+    }
+    details += line;
+}
+
+} // namespace
+
+RealtimeReport ApplyThreadConfig(const RealtimeConfig& config) {
+    RealtimeReport report;
+
+#if defined(_WIN32)
+    if (config.policy != RealtimePolicy::None || !config.cpus.empty()) {
+        AppendDetail(report.details, "realtime scheduling is not supported on this platform");
+    }
+#else
+    if (config.policy != RealtimePolicy::None) {
+        const int policy = config.policy == RealtimePolicy::Fifo ? SCHED_FIFO : SCHED_RR;
+        const int minPriority = sched_get_priority_min(policy);
+        const int maxPriority = sched_get_priority_max(policy);
+
+        sched_param param{};
+        param.sched_priority = config.priority > 0 ? config.priority : (minPriority + maxPriority) / 2;
+        if (param.sched_priority < minPriority) param.sched_priority = minPriority;
+        if (param.sched_priority > maxPriority) param.sched_priority = maxPriority;
+
+        const int err = pthread_setschedparam(pthread_self(), policy, &param);
+        const std::string name = policy == SCHED_FIFO ? "SCHED_FIFO" : "SCHED_RR";
+        if (err == 0) {
+            report.schedulingApplied = true;
+            AppendDetail(report.details, name + " priority " + std::to_string(param.sched_priority));
+        } else {
+            AppendDetail(report.details, name + " not applied: " + std::strerror(err));
+        }
+    }
+
+    if (!config.cpus.empty()) {
+#if defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        std::string cpuList;
+        for (int cpu : config.cpus) {
+            if (cpu < 0 || cpu >= CPU_SETSIZE) continue;
+            CPU_SET(cpu, &set);
+            cpuList += (cpuList.empty() ? "" : ",") + std::to_string(cpu);
+        }
+        const int err = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+        if (err == 0) {
+            report.affinityApplied = true;
+            AppendDetail(report.details, "pinned to CPUs " + cpuList);
+        } else {
+            AppendDetail(report.details, std::string("affinity not applied: ") + std::strerror(err));
+        }
+#else
+        AppendDetail(report.details, "CPU affinity is not supported on this platform");
+#endif
+    }
+#endif
+
+    return report;
+}
+
+bool LockProcessMemory(std::string& details) {
+#if defined(_WIN32)
+    AppendDetail(details, "mlockall is not supported on this platform");
+    return false;
+#else
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+        AppendDetail(details, std::string("mlockall failed: ") + std::strerror(errno));
+        return false;
+    }
+    processMemoryLocked = true;
+    AppendDetail(details, "memory locked");
+    return true;
+#endif
+}
+
+bool UnlockProcessMemory(std::string& details) {
+#if defined(_WIN32)
+    AppendDetail(details, "munlockall is not supported on this platform");
+    return false;
+#else
+    if (munlockall() != 0) {
+        AppendDetail(details, std::string("munlockall failed: ") + std::strerror(errno));
+        return false;
+    }
+    processMemoryLocked = false;
+    AppendDetail(details, "memory unlocked");
+    return true;
+#endif
+}
+
+bool IsProcessMemoryLocked() {
+    return processMemoryLocked;
+}
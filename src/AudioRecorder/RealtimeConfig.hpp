@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Scheduling policy requested for audio threads
+enum class RealtimePolicy {
+    None,       // leave the default (SCHED_OTHER) scheduling untouched
+    Fifo,       // SCHED_FIFO
+    RoundRobin  // SCHED_RR
+};
+
+// Runtime configuration for the capture / denoise / send threads.
+// Everything is optional; an empty config changes nothing.
+struct RealtimeConfig {
+    RealtimePolicy policy = RealtimePolicy::None;
+    int priority = 0;          // 0 -> middle of the policy's priority range
+    std::vector<int> cpus;     // CPU ids to pin to; empty -> keep current affinity
+    bool lockMemory = false;   // mlockall(MCL_CURRENT | MCL_FUTURE)
+    bool prefault = false;     // touch record/denoise buffers before recording starts
+};
+
+// What was actually applied. Missing privileges are not errors:
+// the corresponding flag stays false and the reason goes to details.
+struct RealtimeReport {
+    bool schedulingApplied = false;
+    bool affinityApplied = false;
+    bool memoryLocked = false;
+    std::string details;
+};
+
+// Apply scheduling policy and CPU affinity to the calling thread.
+// lockMemory is process-wide and handled by LockProcessMemory instead.
+RealtimeReport ApplyThreadConfig(const RealtimeConfig& config);
+
+// Lock all current and future pages of the process into RAM.
+// Returns false (and appends the reason to details) if not permitted.
+bool LockProcessMemory(std::string& details);
+
+// Undo LockProcessMemory (munlockall). Returns false if it failed.
+bool UnlockProcessMemory(std::string& details);
+
+// Whether LockProcessMemory is in effect, no matter which object called it
+bool IsProcessMemoryLocked();
+
+// Grow the vector to hold `count` elements and touch every page,
+// so that later push/insert calls up to `count` never fault or reallocate.
+template <typename T>
+void PrefaultVector(std::vector<T>& vec, size_t count) {
+    if (vec.capacity() < count) {
+        vec.reserve(count);
+    }
+    const size_t oldSize = vec.size();
+    vec.resize(vec.capacity());
+    vec.resize(oldSize);
+}
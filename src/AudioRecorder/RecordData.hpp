@@ -3,15 +3,43 @@
 #include <vector>
 #include <atomic>
 #include <functional>
+#include <cstdint>
+#include <chrono>
+
+#include "RealtimeConfig.hpp"
+#include "AudioBuffer.hpp"
 
 struct RecordData {
-    std::vector<int16_t> audioData;
+    AudioBufferBuilder audioData;
     std::atomic<bool> isRecording;
     unsigned int sampleRate;
 
+    // Stream opened as RTAUDIO_FLOAT32 (fallback format): the callback converts
+    // every buffer to int16 in convertBuffer, which is sized when the stream opens
+    bool floatInput = false;
+    std::vector<int16_t> convertBuffer;
+
     // Optional streaming callback for each captured buffer
     // (samples, numSamples, sampleRate)
     std::function<void(const int16_t*, size_t, unsigned int)> onBuffer;
+
+    // Realtime settings applied by the callback thread on its first buffer
+    RealtimeConfig realtime;
+    std::atomic<bool> realtimeApplied{false};
+    RealtimeReport threadReport;
+
+    // Deadline statistics: a callback misses its deadline when it arrives more than
+    // half a buffer period later than the previous one plus one period, or the
+    // driver reports an overflow. lastCallbackAt is touched only by the callback thread.
+    std::atomic<uint64_t> callbacks{0};
+    std::atomic<uint64_t> deadlineMisses{0};
+    std::atomic<int64_t> maxLatenessUs{0};
+    std::chrono::steady_clock::time_point lastCallbackAt;
+    bool hasLastCallback = false;
+
+    // When the very first buffer arrived, for time-to-first-buffer reporting
+    std::atomic<bool> firstBufferSeen{false};
+    std::chrono::steady_clock::time_point firstBufferAt;
 };
 
 
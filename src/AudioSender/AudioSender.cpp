@@ -1,6 +1,19 @@
 #include "AudioSender.hpp"
 
 #include "../AudioRecorder/NoiseSuppressor.hpp"
+#include "Rtp.hpp"
+
+#include <opus.h>
+
+#include <random>
+#include <stdexcept>
+#include <string>
+
+void OpusEncoderDeleter::operator()(OpusEncoder* ptr) const noexcept {
+    if (ptr) {
+        opus_encoder_destroy(ptr);
+    }
+}
 
 AudioSender::AudioSender(PeerConnectionPtr pc,
                          NoiseSuppressor& suppressor,
@@ -9,38 +22,73 @@ AudioSender::AudioSender(PeerConnectionPtr pc,
     , _suppressor(suppressor)
     , _sampleRate(sampleRate)
 {
+    std::random_device random;
+    _ssrc = random();
+    _sequence = static_cast<uint16_t>(random());
+    _timestamp = random();
+
+    int error = OPUS_OK;
+    _encoder.reset(opus_encoder_create(kOpusSampleRate, 1, OPUS_APPLICATION_VOIP, &error));
+    if (error != OPUS_OK || !_encoder) {
+        throw std::runtime_error(std::string("Failed to create Opus encoder: ") + opus_strerror(error));
+    }
+    opus_encoder_ctl(_encoder.get(), OPUS_SET_BITRATE(kBitrate));
+    _encoded.resize(kMaxPacketBytes);
 }
 
+AudioSender::~AudioSender() = default;
+
 void AudioSender::AttachTrack() {
     if (!_pc) return;
 
     // Describe an outgoing audio track (Opus)
     rtc::Description::Audio audioDesc("audio", rtc::Description::Direction::SendOnly);
-    audioDesc.addOpusCodec(111);
-    audioDesc.setBitrate(64000); // 64 kbps as a starting point
+    audioDesc.addOpusCodec(kPayloadType);
+    audioDesc.setBitrate(kBitrate); // 64 kbps as a starting point
+    // Lets the remote side map incoming packets to this track by SSRC
+    audioDesc.addSSRC(_ssrc, "audio-sender");
 
     _audioTrack = _pc->addTrack(audioDesc);
 }
 
+void AudioSender::SetRealtimeConfig(const RealtimeConfig& config, size_t maxSamples) {
+    _suppressor.SetRealtimeConfig(config, maxSamples, _sampleRate);
+    if (config.prefault) {
+        // Resampled to 48kHz; RNNoise emits whole 480-sample frames, so one call
+        // can return up to a frame more. Less than one Opus frame stays pending.
+        const size_t processed = maxSamples * kOpusSampleRate / _sampleRate + 2 + 480;
+        PrefaultVector(_processed, processed);
+        PrefaultVector(_pending, processed + kFrameSamples);
+        PrefaultVector(_packet, Rtp::kHeaderSize + kMaxPacketBytes);
+    }
+}
+
 void AudioSender::OnAudioBuffer(const int16_t* samples, size_t numSamples) {
-    if (!_pc || !_audioTrack || !samples || numSamples == 0) {
+    if (!_pc || !IsOpen() || !samples || numSamples == 0) {
         return;
     }
 
-    // Optionally denoise
-    std::vector<int16_t> processed = _suppressor.IsEnabled()
-        ? _suppressor.ProcessSamples(samples, numSamples, _sampleRate, _sampleRate)
-        : std::vector<int16_t>(samples, samples + numSamples);
-
-    // libdatachannel transports media over RTP; for simple custom sources one
-    // common pattern is to send the raw PCM frames as binary messages on the track.
-    // Exact handling on the receiver side is up to your application.
+    // Optionally denoise (passes samples through unchanged when disabled);
+    // either way the result is at 48kHz, the rate Opus is encoded at
+    _suppressor.ProcessSamples(samples, numSamples, _sampleRate, kOpusSampleRate, _processed);
+    _pending.insert(_pending.end(), _processed.begin(), _processed.end());
 
-    const std::byte* begin = reinterpret_cast<const std::byte*>(processed.data());
-    const std::byte* end   = begin + processed.size() * sizeof(int16_t);
-    rtc::binary frame(begin, end);
-
-    _audioTrack->send(frame);
+    // Opus encodes whole frames only: nothing is sent until one is complete and
+    // the remainder waits for the next buffer. The RTP timestamp (48kHz clock)
+    // advances by exactly the samples each packet carries.
+    size_t consumed = 0;
+    while (_pending.size() - consumed >= kFrameSamples) {
+        const opus_int32 bytes = opus_encode(_encoder.get(), _pending.data() + consumed,
+                                             static_cast<int>(kFrameSamples),
+                                             _encoded.data(), static_cast<opus_int32>(_encoded.size()));
+        consumed += kFrameSamples;
+        if (bytes > 0) {
+            // Tracks carry RTP only, so wrap the Opus packet into a minimal RTP packet
+            Rtp::WritePacket(_packet, kPayloadType, _sequence++, _timestamp, _ssrc,
+                             _encoded.data(), static_cast<size_t>(bytes));
+            _audioTrack->send(_packet.data(), _packet.size());
+        }
+        _timestamp += static_cast<uint32_t>(kFrameSamples);
+    }
+    _pending.erase(_pending.begin(), _pending.begin() + consumed);
 }
-
-
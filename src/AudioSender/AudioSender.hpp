@@ -7,20 +7,32 @@
 
 #include "rtc/rtc.hpp"
 
+#include "../AudioRecorder/RealtimeConfig.hpp"
+
 class AudioRecorder;
 class NoiseSuppressor;
 
+// Forward declaration - opus.h is included in the cpp file
+struct OpusEncoder;
+
+struct OpusEncoderDeleter {
+    void operator()(OpusEncoder* ptr) const noexcept;
+};
+
 // This class is responsible for:
 //  - adding an outgoing audio track to a libdatachannel PeerConnection
 //  - exposing a callback that accepts raw PCM buffers from AudioRecorder
 //  - optionally passing them through NoiseSuppressor before sending
+//  - encoding the result to Opus (20 ms frames, 48 kHz) and sending it as RTP
 class AudioSender {
 public:
     using PeerConnectionPtr = std::shared_ptr<rtc::PeerConnection>;
 
+    // Opus always runs at 48kHz: input at any other sampleRate is resampled
     AudioSender(PeerConnectionPtr pc,
                 NoiseSuppressor& suppressor,
                 unsigned int sampleRate);
+    ~AudioSender();
 
     // Attach an audio track (Opus) to the peer connection.
     // Should be called before you create the offer / start negotiation.
@@ -30,13 +42,37 @@ public:
     // Typically called from AudioRecorder's capture callback.
     void OnAudioBuffer(const int16_t* samples, size_t numSamples);
 
+    // Pre-fault the suppressor and the send buffer for buffers of up to maxSamples
+    // (when config.prefault is set). Call before capture starts.
+    void SetRealtimeConfig(const RealtimeConfig& config, size_t maxSamples);
+
     unsigned int GetSampleRate() const { return _sampleRate; }
 
+    // Buffers are dropped until the track is open (connection established)
+    bool IsOpen() const { return _audioTrack && _audioTrack->isOpen(); }
+
 private:
     PeerConnectionPtr _pc;
     std::shared_ptr<rtc::Track> _audioTrack;
     NoiseSuppressor& _suppressor;
     unsigned int _sampleRate;
+
+    static constexpr int kPayloadType = 111;
+    static constexpr unsigned int kOpusSampleRate = 48000;
+    static constexpr size_t kFrameSamples = 960;     // 20 ms at 48kHz
+    static constexpr int kBitrate = 64000;
+    static constexpr size_t kMaxPacketBytes = 1275;  // largest single-frame Opus packet
+    uint32_t _ssrc;
+    uint16_t _sequence;
+    uint32_t _timestamp;
+
+    std::unique_ptr<OpusEncoder, OpusEncoderDeleter> _encoder;
+
+    // All reused between calls:
+    std::vector<int16_t> _processed;      // denoised samples of the current buffer, at 48kHz
+    std::vector<int16_t> _pending;        // samples not yet encoded (less than one frame)
+    std::vector<unsigned char> _encoded;  // one Opus packet
+    rtc::binary _packet;                  // the same packet with its RTP header
 };
 
 
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Immutable, reference-counted mono int16 audio stored as a list of blocks.
+// Copies are cheap (they share the blocks), so the same recording can be
+// handed to several saving workers / processors without duplicating samples.
+// All blocks except the last one hold exactly BlockSamples() samples.
+class AudioBuffer {
+public:
+    using Block = std::vector<int16_t>;
+
+    AudioBuffer() = default;
+
+    // Adopt a vector without copying it (becomes a single block)
+    static AudioBuffer FromVector(std::vector<int16_t>&& samples) {
+        AudioBuffer buffer;
+        buffer._size = samples.size();
+        buffer._blockSamples = samples.size();
+        if (!samples.empty()) {
+            auto blocks = std::make_shared<std::vector<Block>>();
+            blocks->push_back(std::move(samples));
+            buffer._blocks = std::move(blocks);
+        }
+        return buffer;
+    }
+
+    // Copy raw samples into a new buffer (single block)
+    static AudioBuffer FromSamples(const int16_t* samples, size_t numSamples) {
+        return FromVector(std::vector<int16_t>(samples, samples + numSamples));
+    }
+
+    size_t Size() const { return _size; }
+    bool Empty() const { return _size == 0; }
+
+    size_t BlockCount() const { return _blocks ? _blocks->size() : 0; }
+    size_t BlockSamples() const { return _blockSamples; }
+    const int16_t* BlockData(size_t block) const { return (*_blocks)[block].data(); }
+    size_t BlockSize(size_t block) const { return (*_blocks)[block].size(); }
+
+    int16_t operator[](size_t index) const {
+        return (*_blocks)[index / _blockSamples][index % _blockSamples];
+    }
+
+    // Calls fn(const int16_t* samples, size_t numSamples) for every block in order
+    template <typename Fn>
+    void ForEachBlock(Fn&& fn) const {
+        for (size_t i = 0; i < BlockCount(); ++i) {
+            fn(BlockData(i), BlockSize(i));
+        }
+    }
+
+    // Flat copy, for APIs that need contiguous samples
+    std::vector<int16_t> ToVector() const {
+        std::vector<int16_t> result;
+        result.reserve(_size);
+        ForEachBlock([&result](const int16_t* samples, size_t numSamples) {
+            result.insert(result.end(), samples, samples + numSamples);
+        });
+        return result;
+    }
+
+private:
+    friend class AudioBufferBuilder;
+
+    std::shared_ptr<const std::vector<Block>> _blocks;
+    size_t _size = 0;
+    size_t _blockSamples = 0;
+};
+
+// Accumulates samples into fixed-size blocks and freezes them into an AudioBuffer.
+// Appending never moves already stored samples, so the capture callback
+// only allocates when it starts a new block (and not at all after Reserve()).
+class AudioBufferBuilder {
+public:
+    static constexpr size_t kDefaultBlockSamples = 4096;
+
+    explicit AudioBufferBuilder(size_t blockSamples = kDefaultBlockSamples)
+        : _blockSamples(blockSamples ? blockSamples : kDefaultBlockSamples) {}
+
+    // Allocate and touch enough blocks for numSamples
+    void Reserve(size_t numSamples) {
+        const size_t needed = (numSamples + _blockSamples - 1) / _blockSamples;
+        while (_blocks.size() < needed) {
+            AudioBuffer::Block block;
+            block.resize(_blockSamples);
+            block.clear();
+            _blocks.push_back(std::move(block));
+        }
+    }
+
+    void Append(const int16_t* samples, size_t numSamples) {
+        while (numSamples > 0) {
+            const size_t block = _size / _blockSamples;
+            if (block == _blocks.size()) {
+                _blocks.emplace_back();
+                _blocks.back().reserve(_blockSamples);
+            }
+            AudioBuffer::Block& target = _blocks[block];
+            const size_t count = std::min(numSamples, _blockSamples - target.size());
+            target.insert(target.end(), samples, samples + count);
+            samples += count;
+            numSamples -= count;
+            _size += count;
+        }
+    }
+
+    size_t Size() const { return _size; }
+
+    void Clear() {
+        _blocks.clear();
+        _size = 0;
+    }
+
+    // Move the collected blocks into an immutable buffer; the builder is left empty
+    AudioBuffer Build() {
+        _blocks.resize((_size + _blockSamples - 1) / _blockSamples);
+        AudioBuffer buffer;
+        buffer._size = _size;
+        buffer._blockSamples = _blockSamples;
+        if (!_blocks.empty()) {
+            buffer._blocks = std::make_shared<const std::vector<AudioBuffer::Block>>(std::move(_blocks));
+        }
+        Clear();
+        return buffer;
+    }
+
+private:
+    size_t _blockSamples;
+    std::vector<AudioBuffer::Block> _blocks;
+    size_t _size = 0;
+};
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Minimal RTP framing (RFC 3550) for one media payload per packet.
+// libdatachannel tracks only carry RTP: SRTP and the payload-type / SSRC
+// routing on the remote side both need a valid header, so AudioSender wraps
+// every Opus packet with WritePacket and AudioReceiver unwraps it with ReadPacket.
+namespace Rtp {
+
+constexpr size_t kHeaderSize = 12;
+
+struct Packet {
+    uint8_t payloadType = 0;
+    uint16_t sequence = 0;
+    uint32_t timestamp = 0;
+    uint32_t ssrc = 0;
+    // Points into the buffer passed to ReadPacket
+    const unsigned char* payload = nullptr;
+    size_t payloadSize = 0;
+};
+
+inline void WritePacket(std::vector<std::byte>& packet,
+                        uint8_t payloadType, uint16_t sequence,
+                        uint32_t timestamp, uint32_t ssrc,
+                        const unsigned char* payload, size_t payloadSize) {
+    packet.resize(kHeaderSize + payloadSize);
+    std::byte* p = packet.data();
+
+    p[0] = std::byte{0x80};  // version 2, no padding / extension / CSRC
+    p[1] = std::byte{static_cast<uint8_t>(payloadType & 0x7F)};
+    p[2] = std::byte{static_cast<uint8_t>(sequence >> 8)};
+    p[3] = std::byte{static_cast<uint8_t>(sequence)};
+    for (int i = 0; i < 4; ++i) {
+        p[4 + i] = std::byte{static_cast<uint8_t>(timestamp >> (24 - 8 * i))};
+        p[8 + i] = std::byte{static_cast<uint8_t>(ssrc >> (24 - 8 * i))};
+    }
+    for (size_t i = 0; i < payloadSize; ++i) {
+        p[kHeaderSize + i] = std::byte{payload[i]};
+    }
+}
+
+// Returns false for anything that is not a well-formed RTP version 2 packet
+inline bool ReadPacket(const std::byte* data, size_t size, Packet& packet) {
+    packet = Packet();
+    if (size < kHeaderSize) {
+        return false;
+    }
+    const uint8_t first = static_cast<uint8_t>(data[0]);
+    if ((first >> 6) != 2) {
+        return false;
+    }
+
+    // Every length below comes from the remote peer, so each one is checked
+    // against the packet size before it is used
+    size_t offset = kHeaderSize + 4 * (first & 0x0F);  // CSRC list
+    if (offset > size) {
+        return false;
+    }
+    if (first & 0x10) {
+        // Header extension: 4 byte header, length in 32-bit words
+        if (size - offset < 4) return false;
+        const size_t words = (static_cast<size_t>(data[offset + 2]) << 8) | static_cast<size_t>(data[offset + 3]);
+        offset += 4 + 4 * words;
+        if (offset > size) return false;
+    }
+    size_t end = size;
+    if (first & 0x20) {
+        // Padding: last byte holds the padding length, which counts itself
+        const size_t padding = static_cast<uint8_t>(data[size - 1]);
+        if (padding == 0 || padding > size - offset) return false;
+        end -= padding;
+    }
+
+    auto byteAt = [data](size_t i) { return static_cast<uint32_t>(data[i]); };
+    packet.payloadType = static_cast<uint8_t>(byteAt(1) & 0x7F);
+    packet.sequence = static_cast<uint16_t>((byteAt(2) << 8) | byteAt(3));
+    packet.timestamp = (byteAt(4) << 24) | (byteAt(5) << 16) | (byteAt(6) << 8) | byteAt(7);
+    packet.ssrc = (byteAt(8) << 24) | (byteAt(9) << 16) | (byteAt(10) << 8) | byteAt(11);
+    packet.payload = reinterpret_cast<const unsigned char*>(data + offset);
+    packet.payloadSize = end - offset;
+    return true;
+}
+
+} // namespace Rtp
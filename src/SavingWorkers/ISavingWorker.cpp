@@ -2,11 +2,21 @@
 
 #include <string>
 #include <cstdint>
+#include <utility>
 
-void ISavingWorker::SetAudioData(const std::vector<int16_t>& audioData) {
-    _audioData = audioData;
+void ISavingWorker::SetAudioData(AudioBuffer audioData) {
+    _audioData = std::move(audioData);
     _setter_called = true;
 }
+void ISavingWorker::SetAudioData(const std::vector<int16_t>& audioData) {
+    SetAudioData(AudioBuffer::FromSamples(audioData.data(), audioData.size()));
+}
+void ISavingWorker::SetAudioData(std::vector<int16_t>&& audioData) {
+    SetAudioData(AudioBuffer::FromVector(std::move(audioData)));
+}
+void ISavingWorker::SetAudioData(const int16_t* samples, size_t numSamples) {
+    SetAudioData(AudioBuffer::FromSamples(samples, numSamples));
+}
 void ISavingWorker::SetSampleRate(uint32_t sampleRate) {
     _sampleRate = sampleRate;
 }
@@ -4,6 +4,8 @@
 #include <vector>
 #include <cstdint>
 
+#include "AudioBuffer.hpp"
+
 struct SavingWorkerException : public std::runtime_error {
     SavingWorkerException(const std::string& what) : std::runtime_error(what) {}
 };
@@ -14,10 +16,14 @@ public:
     virtual ~ISavingWorker() = default;
     virtual bool Save() = 0;
     void SetSampleRate();
+    // Shares the buffer, no samples are copied
+    void SetAudioData(AudioBuffer audioData);
     void SetAudioData(const std::vector<int16_t>& audioData);
+    void SetAudioData(std::vector<int16_t>&& audioData);
+    void SetAudioData(const int16_t* samples, size_t numSamples);
     void SetSampleRate(uint32_t sampleRate);
 protected:
-    std::vector<int16_t> _audioData;
+    AudioBuffer _audioData;
     unsigned int _sampleRate;
     bool _setter_called;
 };
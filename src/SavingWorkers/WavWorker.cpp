@@ -4,7 +4,7 @@
 
 bool WavWorker::Save() {
     if (!_setter_called) {throw SavingWorkerException("Sample rate must be specified");}
-    if (_audioData.size() == 0) {
+    if (_audioData.Size() == 0) {
         std::cout << "No audio data to save!" << std::endl;
         return false;
     }
@@ -20,19 +20,22 @@ bool WavWorker::Save() {
         return false;
     }
 
-    // Записываем данные в файл
-    sf_count_t framesWritten = sf_write_short(outfile, _audioData.data(), _audioData.size());
+    // Записываем данные в файл поблочно
+    sf_count_t framesWritten = 0;
+    _audioData.ForEachBlock([&](const int16_t* samples, size_t numSamples) {
+        framesWritten += sf_write_short(outfile, samples, numSamples);
+    });
     sf_close(outfile);
 
-    if (framesWritten != static_cast<sf_count_t>(_audioData.size())) {
-        std::cout << "Error: wrote " << framesWritten << " samples, expected " << _audioData.size() << std::endl;
+    if (framesWritten != static_cast<sf_count_t>(_audioData.Size())) {
+        std::cout << "Error: wrote " << framesWritten << " samples, expected " << _audioData.Size() << std::endl;
         return false;
     }
-    for (int i = 0; i < 1000 && i < static_cast<int>(_audioData.size()); i++) {
+    for (int i = 0; i < 1000 && i < static_cast<int>(_audioData.Size()); i++) {
         std::cout << _audioData[i] << " ";
     }
 
-    std::cout << "Successfully saved " << _audioData.size() << " samples to " << _filename << std::endl;
+    std::cout << "Successfully saved " << _audioData.Size() << " samples to " << _filename << std::endl;
     return true;
 }
 
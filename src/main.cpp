@@ -2,12 +2,167 @@
 #include "SavingWorkers/WavWorker.hpp"
 #include "AudioRecorder/AudioRecorder.hpp"
 #include "AudioRecorder/NoiseSuppressor.hpp"
+#include "AudioReceiver/AudioReceiver.hpp"
 
 #include <iostream>
 #include <vector>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <string>
 
-int main()
+// Prints the capture callback deadline-miss rate without and with realtime
+// scheduling / memory locking / pre-faulting. The callback also runs the noise
+// suppressor, like it does when feeding AudioSender. Runs go in ABBA order
+// (default, realtime, realtime, default) so that changes in system load hit both equally.
+static void CompareRealtime(unsigned int milliseconds, const std::vector<int>& cpus)
 {
+    RealtimeConfig realtime;
+    realtime.policy = RealtimePolicy::Fifo;
+    realtime.cpus = cpus;
+    realtime.lockMemory = true;
+    realtime.prefault = true;
+    const RealtimeConfig defaults;
+
+    uint64_t callbacks[2] = {0, 0};
+    uint64_t misses[2] = {0, 0};
+    double maxLateness[2] = {0.0, 0.0};
+    for (bool useRealtime : {false, true, true, false}) {
+        const int run = useRealtime ? 1 : 0;
+        const RealtimeConfig& config = useRealtime ? realtime : defaults;
+
+        auto worker = std::make_shared<WavWorker>(useRealtime ? "rec_rt.wav" : "rec_default.wav");
+        AudioRecorder recorder(worker);
+        NoiseSuppressor suppressor;
+        suppressor.SetEnabled(true);
+        std::vector<int16_t> denoised;
+
+        // mlockall is process-wide: the default runs unlock what the realtime runs locked
+        recorder.SetRealtimeConfig(config);
+        std::cout << (useRealtime ? "Realtime" : "Default") << " run, memory "
+                  << (IsProcessMemoryLocked() ? "locked" : "not locked") << std::endl;
+        suppressor.SetRealtimeConfig(config, recorder.GetBufferFrames(), recorder.GetSampleRate());
+        if (config.prefault) {
+            PrefaultVector(denoised, recorder.GetBufferFrames() + 480);
+        }
+        recorder.SetOnBufferCallback([&](const int16_t* samples, size_t numSamples, unsigned int rate) {
+            suppressor.ProcessSamples(samples, numSamples, rate, rate, denoised);
+        });
+
+        recorder.Record(milliseconds);
+        callbacks[run] += recorder.GetCallbackCount();
+        misses[run] += recorder.GetDeadlineMisses();
+        maxLateness[run] = std::max(maxLateness[run], recorder.GetMaxLatenessMs());
+        if (useRealtime) {
+            std::cout << "Applied: " << recorder.GetRealtimeReport().details << std::endl;
+        }
+    }
+
+    const char* names[2] = {"without realtime config", "with realtime config   "};
+    for (int run = 0; run < 2; ++run) {
+        const double rate = callbacks[run] ? 100.0 * misses[run] / callbacks[run] : 0.0;
+        std::cout << "Deadline miss rate " << names[run] << ": " << rate << "% ("
+                  << misses[run] << "/" << callbacks[run] << "), max lateness "
+                  << maxLateness[run] << " ms" << std::endl;
+    }
+}
+
+// Time from constructing AudioRecorder to its first captured buffer, cold
+// (device cache removed, full probe) vs warm (cached stream parameters).
+// Each is the median of several starts.
+static void CompareStartup(int starts)
+{
+    double medians[2] = {0.0, 0.0};
+    for (bool warm : {false, true}) {
+        std::vector<double> firstBuffer;
+        for (int i = 0; i < starts; ++i) {
+            if (!warm) {
+                DeviceProbeCache().Invalidate();
+            }
+            auto worker = std::make_shared<WavWorker>("rec_startup.wav");
+            AudioRecorder recorder(worker);
+            recorder.Record(200);
+            firstBuffer.push_back(recorder.GetTimeToFirstBufferMs());
+        }
+        std::sort(firstBuffer.begin(), firstBuffer.end());
+        medians[warm ? 1 : 0] = firstBuffer[firstBuffer.size() / 2];
+    }
+    std::cout << "Time to first buffer, cold start: " << medians[0] << " ms" << std::endl;
+    std::cout << "Time to first buffer, warm start: " << medians[1] << " ms" << std::endl;
+}
+
+// "0,2,3" -> {0, 2, 3}
+static std::vector<int> ParseCpuList(const std::string& list)
+{
+    std::vector<int> cpus;
+    size_t start = 0;
+    while (start < list.size()) {
+        size_t end = list.find(',', start);
+        if (end == std::string::npos) end = list.size();
+        if (end > start) {
+            cpus.push_back(std::stoi(list.substr(start, end - start)));
+        }
+        start = end + 1;
+    }
+    return cpus;
+}
+
+// Mixes three synthetic participants (sine tones) through AudioReceiver
+// and saves the full mix and the mix-minus of the first participant
+static void MixDemo(unsigned int milliseconds)
+{
+    const unsigned int sampleRate = 48000;
+    AudioReceiver receiver(sampleRate);
+    const double tones[] = {220.0, 330.0, 440.0};
+    const std::string ids[] = {"a", "b", "c"};
+
+    AudioBufferBuilder mixOut;
+    AudioBufferBuilder minusOut;
+    std::vector<int16_t> packet(receiver.GetFrameSamples());
+    std::vector<int16_t> mix;
+    std::map<std::string, std::vector<int16_t>> mixMinus;
+
+    const size_t frames = milliseconds * sampleRate / 1000 / receiver.GetFrameSamples();
+    for (size_t f = 0; f < frames; ++f) {
+        for (int p = 0; p < 3; ++p) {
+            for (size_t i = 0; i < packet.size(); ++i) {
+                const double t = static_cast<double>(f * packet.size() + i) / sampleRate;
+                packet[i] = static_cast<int16_t>(12000 * std::sin(2 * M_PI * tones[p] * t));
+            }
+            receiver.OnAudioBuffer(ids[p], packet.data(), packet.size());
+        }
+        receiver.Mix(mix, &mixMinus);
+        mixOut.Append(mix.data(), mix.size());
+        minusOut.Append(mixMinus["a"].data(), mixMinus["a"].size());
+    }
+
+    auto mixWorker = std::make_shared<WavWorker>("mix_all.wav");
+    mixWorker->SetSampleRate(sampleRate);
+    mixWorker->SetAudioData(mixOut.Build());
+    mixWorker->Save();
+
+    auto minusWorker = std::make_shared<WavWorker>("mix_minus_a.wav");
+    minusWorker->SetSampleRate(sampleRate);
+    minusWorker->SetAudioData(minusOut.Build());
+    minusWorker->Save();
+}
+
+int main(int argc, char** argv)
+{
+    if (argc > 1 && std::strcmp(argv[1], "--rt-compare") == 0) {
+        // Optional CPU list to pin the capture thread to, e.g. --rt-compare 2,3
+        CompareRealtime(3000, argc > 2 ? ParseCpuList(argv[2]) : std::vector<int>());
+        return 0;
+    }
+    if (argc > 1 && std::strcmp(argv[1], "--startup-compare") == 0) {
+        CompareStartup(5);
+        return 0;
+    }
+    if (argc > 1 && std::strcmp(argv[1], "--mix-demo") == 0) {
+        MixDemo(5000);
+        return 0;
+    }
+
     // 1) Record once using the raw recorder (no suppression in the callback)
     std::cout << "Recording raw audio (shared for both tests)..." << std::endl;
     auto rawWorker = std::make_shared<WavWorker>("rec_raw.wav");
@@ -15,7 +170,7 @@ int main()
     recorder.Record(5000);
     recorder.SaveData(); 
 
-    // 2) Access the same recorded buffer and run noise suppression offline
+    // 2) Access the same recorded buffer (shared with rawWorker) and run noise suppression offline
     const auto& rawData = recorder.GetAudioData();
     const auto sampleRate = recorder.GetSampleRate();
 
@@ -23,17 +178,12 @@ int main()
     suppressor.SetEnabled(true);
 
     std::cout << "Running noise suppression over recorded buffer..." << std::endl;
-    std::vector<int16_t> denoised = suppressor.ProcessSamples(
-        rawData.data(),
-        rawData.size(),
-        sampleRate,
-        sampleRate
-    );
+    AudioBuffer denoised = suppressor.ProcessSamples(rawData, sampleRate, sampleRate);
 
     // 3) Save the denoised version using a separate worker
     auto denoisedWorker = std::make_shared<WavWorker>("rec_denoised.wav");
     denoisedWorker->SetSampleRate(sampleRate);
-    denoisedWorker->SetAudioData(denoised);
+    denoisedWorker->SetAudioData(std::move(denoised));
     denoisedWorker->Save();
 
     std::cout << "Done. Compare rec_raw.wav and rec_denoised.wav (same recording, processed vs. unprocessed)." << std::endl;
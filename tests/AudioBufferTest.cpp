@@ -0,0 +1,94 @@
+// AudioBufferBuilder block layout: Reserve / Append / Build must keep samples
+// in order, fill every block but the last, and drop reserved blocks left unused.
+
+#include "AudioBuffer.hpp"
+
+#include <iostream>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+void Check(bool condition, const char* what) {
+    if (!condition) {
+        std::cout << "FAIL: " << what << std::endl;
+        ++failures;
+    }
+}
+
+std::vector<int16_t> Ramp(size_t count) {
+    std::vector<int16_t> samples(count);
+    for (size_t i = 0; i < count; ++i) {
+        samples[i] = static_cast<int16_t>(i * 7 - 1000);
+    }
+    return samples;
+}
+
+} // namespace
+
+int main() {
+    // Small blocks, appends that straddle block edges, more reserved than used
+    {
+        const std::vector<int16_t> source = Ramp(29);
+        AudioBufferBuilder builder(8);
+        builder.Reserve(60);
+        for (size_t offset = 0; offset < source.size(); offset += 3) {
+            builder.Append(source.data() + offset, std::min<size_t>(3, source.size() - offset));
+        }
+        Check(builder.Size() == 29, "builder size");
+
+        const AudioBuffer buffer = builder.Build();
+        Check(builder.Size() == 0, "builder empty after Build");
+        Check(buffer.Size() == 29 && buffer.BlockSamples() == 8, "buffer size");
+        Check(buffer.BlockCount() == 4, "unused reserved blocks dropped");
+        Check(buffer.BlockSize(0) == 8 && buffer.BlockSize(1) == 8 && buffer.BlockSize(2) == 8
+                  && buffer.BlockSize(3) == 5,
+              "all blocks full except the last");
+        Check(buffer.ToVector() == source, "samples in order");
+
+        bool indexed = true;
+        for (size_t i = 0; i < source.size(); ++i) {
+            indexed = indexed && buffer[i] == source[i];
+        }
+        Check(indexed, "operator[] across blocks");
+
+        const AudioBuffer copy = buffer;
+        Check(copy.BlockData(0) == buffer.BlockData(0), "copies share blocks");
+    }
+
+    // Default block size, exact multiple of a block, and reuse after Build
+    {
+        AudioBufferBuilder builder;
+        const std::vector<int16_t> first = Ramp(2 * AudioBufferBuilder::kDefaultBlockSamples);
+        builder.Append(first.data(), first.size());
+        const AudioBuffer buffer = builder.Build();
+        Check(buffer.BlockCount() == 2 && buffer.BlockSize(1) == AudioBufferBuilder::kDefaultBlockSamples,
+              "exact multiple of the block size");
+
+        const std::vector<int16_t> second = Ramp(10);
+        builder.Reserve(100);
+        builder.Append(second.data(), second.size());
+        const AudioBuffer again = builder.Build();
+        Check(again.BlockCount() == 1 && again.ToVector() == second, "builder reusable after Build");
+        Check(buffer.ToVector() == first, "earlier buffer unaffected");
+    }
+
+    // Empty builder and adopted vectors
+    {
+        AudioBufferBuilder builder;
+        builder.Reserve(10000);
+        const AudioBuffer empty = builder.Build();
+        Check(empty.Empty() && empty.BlockCount() == 0, "reserved but empty");
+
+        std::vector<int16_t> samples = Ramp(100);
+        const int16_t* data = samples.data();
+        const AudioBuffer adopted = AudioBuffer::FromVector(std::move(samples));
+        Check(adopted.BlockCount() == 1 && adopted.BlockData(0) == data, "FromVector does not copy");
+    }
+
+    if (failures == 0) {
+        std::cout << "OK: AudioBufferBuilder block layout" << std::endl;
+    }
+    return failures == 0 ? 0 : 1;
+}
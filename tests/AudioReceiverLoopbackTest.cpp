@@ -0,0 +1,143 @@
+// Local loopback: AudioSender on one PeerConnection, AudioReceiver on another,
+// both in this process. A tone sent through the track (Opus over RTP) has to
+// come out of AudioReceiver::Mix() with the same length, level and pitch.
+// Opus is lossy and delays the signal a little, so samples are not compared 1:1.
+
+#include "AudioSender/AudioSender.hpp"
+#include "AudioReceiver/AudioReceiver.hpp"
+#include "AudioRecorder/NoiseSuppressor.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace {
+
+bool WaitFor(const std::function<bool()>& condition, std::chrono::milliseconds timeout) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!condition()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return true;
+}
+
+void Connect(const std::shared_ptr<rtc::PeerConnection>& from, const std::shared_ptr<rtc::PeerConnection>& to) {
+    std::weak_ptr<rtc::PeerConnection> weakTo = to;
+    from->onLocalDescription([weakTo](rtc::Description description) {
+        if (auto pc = weakTo.lock()) pc->setRemoteDescription(description);
+    });
+    from->onLocalCandidate([weakTo](rtc::Candidate candidate) {
+        if (auto pc = weakTo.lock()) pc->addRemoteCandidate(candidate);
+    });
+}
+
+double Rms(const int16_t* samples, size_t count) {
+    double sum = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        sum += static_cast<double>(samples[i]) * samples[i];
+    }
+    return count ? std::sqrt(sum / count) : 0.0;
+}
+
+size_t ZeroCrossings(const int16_t* samples, size_t count) {
+    size_t crossings = 0;
+    for (size_t i = 1; i < count; ++i) {
+        crossings += (samples[i - 1] < 0) != (samples[i] < 0);
+    }
+    return crossings;
+}
+
+} // namespace
+
+int main() {
+    const unsigned int sampleRate = 48000;
+    const size_t frameSamples = 480;
+    const size_t frames = 20;  // 200 ms, 10 Opus packets of 20 ms
+    const double tone = 440.0;
+
+    rtc::Configuration config;  // no ICE servers: host candidates over loopback
+    auto offerer = std::make_shared<rtc::PeerConnection>(config);
+    auto answerer = std::make_shared<rtc::PeerConnection>(config);
+    Connect(offerer, answerer);
+    Connect(answerer, offerer);
+
+    // Jitter depth of all frames: playback starts once the whole tone has arrived,
+    // so Mix() below reads it back without underruns or dropped samples
+    AudioReceiver receiver(sampleRate, frameSamples, frames);
+    answerer->onTrack([&receiver](std::shared_ptr<rtc::Track> track) {
+        receiver.AttachTrack("offerer", std::move(track), false);
+    });
+
+    NoiseSuppressor suppressor;  // disabled: only the codec touches the signal
+    AudioSender sender(offerer, suppressor, sampleRate);
+    sender.AttachTrack();
+    offerer->setLocalDescription();
+
+    int result = 0;
+    if (!WaitFor([&sender] { return sender.IsOpen(); }, std::chrono::seconds(15))) {
+        std::cout << "FAIL: sender track did not open" << std::endl;
+        result = 1;
+    }
+
+    std::vector<int16_t> sent(frames * frameSamples);
+    for (size_t i = 0; i < sent.size(); ++i) {
+        sent[i] = static_cast<int16_t>(8000 * std::sin(2 * M_PI * tone * i / sampleRate));
+    }
+
+    std::vector<int16_t> received;
+    if (result == 0) {
+        for (size_t f = 0; f < frames; ++f) {
+            sender.OnAudioBuffer(sent.data() + f * frameSamples, frameSamples);
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+
+        // Silence until the jitter buffer is full, then every frame of the tone
+        std::vector<int16_t> mix;
+        WaitFor([&] {
+            receiver.Mix(mix);
+            if (!received.empty() || Rms(mix.data(), mix.size()) > 0.0) {
+                received.insert(received.end(), mix.begin(), mix.end());
+            }
+            return received.size() >= sent.size();
+        }, std::chrono::seconds(10));
+
+        // Skip the codec start-up (lookahead, first frame) before measuring
+        const size_t skip = 2 * frameSamples;
+        if (received.size() != sent.size()) {
+            std::cout << "FAIL: received " << received.size() << " of " << sent.size() << " samples" << std::endl;
+            result = 1;
+        } else {
+            const size_t count = sent.size() - skip;
+            const double sentRms = Rms(sent.data() + skip, count);
+            const double receivedRms = Rms(received.data() + skip, count);
+            const size_t sentCrossings = ZeroCrossings(sent.data() + skip, count);
+            const size_t receivedCrossings = ZeroCrossings(received.data() + skip, count);
+            std::cout << "RMS sent " << sentRms << ", received " << receivedRms
+                      << "; zero crossings sent " << sentCrossings << ", received " << receivedCrossings
+                      << std::endl;
+            if (receivedRms < 0.5 * sentRms || receivedRms > 1.5 * sentRms) {
+                std::cout << "FAIL: level changed" << std::endl;
+                result = 1;
+            }
+            if (receivedCrossings + 4 < sentCrossings || receivedCrossings > sentCrossings + 4) {
+                std::cout << "FAIL: pitch changed" << std::endl;
+                result = 1;
+            }
+        }
+    }
+
+    offerer->close();
+    answerer->close();
+
+    if (result == 0) {
+        std::cout << "OK: " << sent.size() << " samples of a " << tone
+                  << " Hz tone round-tripped through AudioSender -> AudioReceiver" << std::endl;
+    }
+    return result;
+}
@@ -0,0 +1,71 @@
+// LinearResampler fed in chunks (as NoiseSuppressor does with AudioBuffer blocks
+// and capture buffers) must give the same output as one pass over the signal:
+// no seams at chunk edges, no drift in the output length.
+
+#include "LinearResampler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+std::vector<float> Resample(const std::vector<float>& input, size_t chunk,
+                            unsigned int inputRate, unsigned int outputRate) {
+    LinearResampler resampler;
+    std::vector<float> output;
+    std::vector<float> part;
+    for (size_t offset = 0; offset < input.size(); offset += chunk) {
+        const size_t count = std::min(chunk, input.size() - offset);
+        resampler.Process(input.data() + offset, count, inputRate, outputRate, part);
+        output.insert(output.end(), part.begin(), part.end());
+    }
+    return output;
+}
+
+} // namespace
+
+int main() {
+    const unsigned int rates[][2] = {{44100, 48000}, {48000, 44100}, {16000, 48000}, {48000, 16000}, {48000, 48000}};
+    const size_t chunks[] = {1, 7, 256, 480, 4096};
+
+    std::vector<float> input(3 * 4096 + 123);
+    for (size_t i = 0; i < input.size(); ++i) {
+        input[i] = 0.5f * static_cast<float>(std::sin(0.01 * i) + 0.3 * std::sin(0.37 * i));
+    }
+
+    int failures = 0;
+    for (const auto& rate : rates) {
+        const std::vector<float> onePass = Resample(input, input.size(), rate[0], rate[1]);
+
+        // Output length follows the rate ratio, rounded once for the whole signal.
+        // Outputs cover input[0] .. input[n - 1]: anything later needs the next sample.
+        const uint64_t span = rate[0] == rate[1] ? input.size() : input.size() - 1;
+        const size_t expected = static_cast<size_t>((span * rate[1] + rate[0] - 1) / rate[0]);
+        if (onePass.size() != expected) {
+            std::cout << "FAIL: " << rate[0] << " -> " << rate[1] << " produced " << onePass.size()
+                      << " samples, expected " << expected << std::endl;
+            ++failures;
+        }
+
+        for (size_t chunk : chunks) {
+            const std::vector<float> chunked = Resample(input, chunk, rate[0], rate[1]);
+            float maxDiff = 0.0f;
+            for (size_t i = 0; i < std::min(chunked.size(), onePass.size()); ++i) {
+                maxDiff = std::max(maxDiff, std::fabs(chunked[i] - onePass[i]));
+            }
+            if (chunked.size() != onePass.size() || maxDiff > 1e-6f) {
+                std::cout << "FAIL: " << rate[0] << " -> " << rate[1] << " in chunks of " << chunk
+                          << ": " << chunked.size() << " vs " << onePass.size()
+                          << " samples, max difference " << maxDiff << std::endl;
+                ++failures;
+            }
+        }
+    }
+
+    if (failures == 0) {
+        std::cout << "OK: chunked resampling matches one pass" << std::endl;
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,82 @@
+// Rtp round trip and malformed packets. Packets come from remote peers,
+// so every broken length field has to be rejected, never trusted.
+
+#include "Rtp.hpp"
+
+#include <iostream>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+void Check(bool condition, const char* what) {
+    if (!condition) {
+        std::cout << "FAIL: " << what << std::endl;
+        ++failures;
+    }
+}
+
+std::vector<std::byte> Bytes(std::initializer_list<int> values) {
+    std::vector<std::byte> bytes;
+    for (int value : values) {
+        bytes.push_back(static_cast<std::byte>(value));
+    }
+    return bytes;
+}
+
+bool Read(const std::vector<std::byte>& data, std::vector<unsigned char>& payload) {
+    Rtp::Packet packet;
+    const bool ok = Rtp::ReadPacket(data.data(), data.size(), packet);
+    payload.assign(packet.payload, packet.payload + packet.payloadSize);
+    return ok;
+}
+
+} // namespace
+
+int main() {
+    std::vector<unsigned char> payload;
+
+    const std::vector<unsigned char> sent = {0xFC, 0xFF, 0xFE, 0, 1, 2, 3};
+    std::vector<std::byte> data;
+    Rtp::WritePacket(data, 111, 0xABCD, 0x01020304, 0x12345678, sent.data(), sent.size());
+    Rtp::Packet packet;
+    Check(Rtp::ReadPacket(data.data(), data.size(), packet)
+              && packet.payloadType == 111 && packet.sequence == 0xABCD
+              && packet.timestamp == 0x01020304 && packet.ssrc == 0x12345678
+              && std::vector<unsigned char>(packet.payload, packet.payload + packet.payloadSize) == sent,
+          "round trip");
+
+    // Padding: 2 bytes of payload, then 2 bytes of padding (last byte = 2)
+    Check(Read(Bytes({0xA0, 111, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0x01, 0x02, 0, 2}), payload)
+              && payload == std::vector<unsigned char>{0x01, 0x02},
+          "valid padding");
+
+    // Padding length larger than the packet (P bit set, last byte 0xFF)
+    Check(!Read(Bytes({0xA0, 111, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0x01, 0xFF}), payload),
+          "padding longer than the packet");
+    Check(!Read(Bytes({0xA0, 111, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0x01, 0x00}), payload),
+          "zero padding length");
+
+    // CSRC count pointing past the end
+    Check(!Read(Bytes({0x8F, 111, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0x01, 0x02}), payload),
+          "CSRC list past the end");
+
+    // Extension header truncated, and extension length past the end
+    Check(!Read(Bytes({0x90, 111, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0xBE, 0xDE}), payload),
+          "truncated extension header");
+    Check(!Read(Bytes({0x90, 111, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0xBE, 0xDE, 0xFF, 0xFF}), payload),
+          "extension longer than the packet");
+    Check(Read(Bytes({0x90, 111, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0xBE, 0xDE, 0, 1, 9, 9, 9, 9, 0, 5}), payload)
+              && payload == std::vector<unsigned char>{0, 5},
+          "valid extension");
+
+    // Wrong version and short packets
+    Check(!Read(Bytes({0x40, 111, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0}), payload), "version 1");
+    Check(!Read(Bytes({0x80, 111, 0}), payload), "shorter than the header");
+
+    if (failures == 0) {
+        std::cout << "OK: Rtp round trip and malformed packets" << std::endl;
+    }
+    return failures == 0 ? 0 : 1;
+}